@@ -0,0 +1,101 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "lock_free_ring.hpp"
+
+// brief: multi-producer multi-consumer queue of limited capacity
+// t-param: ElementType - data-type of the element of the channel
+// note: producers are parked while the channel is full (backpressure) and consumers are parked while it is empty;
+// | after closing (see Close) the producers can not add elements anymore, but the consumers can extract the remaining ones.
+// note: the elements are passed through LockFreeRing-class, the mutex is taken only to park or to wake a thread
+template<class ElementType>
+class BoundedChannel {
+    using OptElementType = std::optional<ElementType>;
+
+    LockFreeRing<ElementType> _elements;
+    std::atomic_bool _is_closed{ false };
+    std::atomic_size_t _parked_producers{};
+    std::atomic_size_t _parked_consumers{};
+    std::mutex _park_mutex{};
+    std::condition_variable _not_full{};
+    std::condition_variable _not_empty{};
+
+    // NOTE: the change of the ring and the check of parked threads are separated by the full fence on both sides (the parking thread and the waking one),
+    // | so at least one of them sees the action of the other and the wakeup can not be lost
+    void _Wake(std::atomic_size_t& parked, std::condition_variable& condition) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed)) {
+            std::lock_guard lock(_park_mutex);
+            condition.notify_one();
+        }
+    }
+
+    template<class PredicateType>
+    void _Park(std::atomic_size_t& parked, std::condition_variable& condition, PredicateType&& predicate) {
+        std::unique_lock lock(_park_mutex);
+        ++parked;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, predicate);
+        --parked;
+    }
+
+    public:
+#pragma region constructors / destructor
+    BoundedChannel(const size_t capacity)
+        : _elements{ capacity } {}
+
+    BoundedChannel(const BoundedChannel&) = delete;
+    BoundedChannel& operator=(const BoundedChannel&) = delete;
+#pragma endregion constructors / destructor
+
+    // brief: adds the element to the channel, parks the calling thread while the channel is full
+    // return: false if the channel is closed and the element is not added
+    // note: the capacity of the channel is the capacity of LockFreeRing-class (it is rounded up to the power of two)
+    template<class... ArgsTypes>
+    bool Emplace(ArgsTypes&&... args) {
+        ElementType new_element(std::forward<ArgsTypes>(args)...);
+        while (true) {
+            if (_is_closed)
+                return false;
+            if (_elements.push_back(std::move(new_element))) {
+                _Wake(_parked_consumers, _not_empty);
+                return true;
+            }
+            _Park(_parked_producers, _not_full, [this]() { return _is_closed || _elements.size() < _elements.capacity(); });
+        }
+    }
+
+    // brief: extracts the oldest element of the channel, parks the calling thread while the channel is empty
+    // return: the element or std::nullopt if the channel is closed and empty
+    OptElementType Extract() {
+        while (true) {
+            if (OptElementType result{ _elements.ExtractFront() }; result.has_value()) {
+                _Wake(_parked_producers, _not_full);
+                return result;
+            }
+            if (_is_closed) {
+                // NOTE: the element added right before the closing must not be lost
+                return _elements.ExtractFront();
+            }
+            _Park(_parked_consumers, _not_empty, [this]() { return _is_closed || !_elements.empty(); });
+        }
+    }
+
+    // brief: forbids to add new elements and wakes all parked producers and consumers
+    void Close() {
+        {
+            std::lock_guard lock(_park_mutex);
+            _is_closed = true;
+        }
+        _not_full.notify_all();
+        _not_empty.notify_all();
+    }
+
+    bool IsClosed() const noexcept {
+        return _is_closed;
+    }
+
+    size_t size() const noexcept {
+        return _elements.size();
+    }
+};
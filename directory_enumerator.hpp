@@ -0,0 +1,710 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "path_arena.hpp"
+#include "io_uring.hpp"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <climits>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <sys/sysmacros.h>
+#endif
+
+// brief: the way to read entries of OS catalogs
+// note: LINUX_GETDENTS - reads entries by large buffers with getdents64 and takes type of entry from d_type, so the stat is called only if the type is unknown
+// note: LINUX_OPENAT - the same as LINUX_GETDENTS, but opens catalogs relative to descriptors of their parents and keeps names in PathArena-class,
+// | so the full path is built only on demand
+// note: LINUX_IO_URING - the same as LINUX_OPENAT, but the found sub catalogs are opened in advance and the metadata of entries is read
+// | by asynchronous operations of io_uring, so the waiting of the disk is overlapped with the scan of catalogs
+enum class ENUMERATION_ENGINE : uint8_t { STD_FILESYSTEM, LINUX_GETDENTS, LINUX_OPENAT, LINUX_IO_URING };
+
+// brief: enumerates entries of OS catalogs; every walker owns own instance
+// t-param: Engine - the way to read entries of OS catalog
+// note: every specialization provides:
+// | DirectoryType - data-type of catalog which is waiting for enumeration;
+// | EntryType - data-type of entry of catalog which has is_directory() and path() methods;
+// | ToDirectory(entry) - converts EntryType (or fs::directory_entry of the initial catalog) to DirectoryType;
+// | GetPath(directory) - returns full path of DirectoryType;
+// | ForEach(directory, action) - calls the action for every EntryType of the catalog.
+template<ENUMERATION_ENGINE Engine>
+struct DirectoryEnumerator;
+
+template<>
+struct DirectoryEnumerator<ENUMERATION_ENGINE::STD_FILESYSTEM> {
+    using DirectoryType = fs::directory_entry;
+    using EntryType = fs::directory_entry;
+
+    static const DirectoryType& ToDirectory(const fs::directory_entry& entry) noexcept {
+        return entry;
+    }
+
+    static const fs::path& GetPath(const DirectoryType& directory) noexcept {
+        return directory.path();
+    }
+
+    template<class ActionType>
+    static void ForEach(const DirectoryType& directory, ActionType&& action) {
+        for (const fs::directory_entry& entry : fs::directory_iterator(directory, fs::directory_options::skip_permission_denied))
+            action(entry);
+    }
+};
+
+#ifdef __linux__
+// brief: owns the file descriptor and closes it in destructor
+class FileDescriptor {
+    int _fd;
+
+    public:
+    explicit FileDescriptor(const int fd = -1) noexcept
+        : _fd{ fd } {}
+
+    FileDescriptor(FileDescriptor&& other) noexcept
+        : _fd{ std::exchange(other._fd, -1) } {}
+
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept {
+        std::swap(_fd, other._fd);
+        return *this;
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor() {
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+
+    int get() const noexcept {
+        return _fd;
+    }
+
+    bool is_valid() const noexcept {
+        return _fd >= 0;
+    }
+};
+
+// brief: the limit of descriptors of the scanned catalogs which are kept opened by their sub catalogs waiting for enumeration
+// | (see DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_OPENAT>::DirectoryType)
+// note: every queued catalog may keep the descriptor of its parent, so the wide walk would keep more descriptors than the process may open;
+// | the limit is common for all walkers, the sub catalogs of the catalog which does not fit the limit are opened by full path;
+// | the descriptors which are opened in advance by LINUX_IO_URING take the places of the limit too
+class KeptDescriptors {
+    using SharedFileDescriptor = std::shared_ptr<FileDescriptor>;
+
+    static inline std::atomic_size_t _kept{};
+
+    size_t _limit{ GetDefaultLimit() };
+
+    public:
+    static constexpr size_t MAX_LIMIT{ 4096 };
+
+    // return: the half of the limit of descriptors of the process (RLIMIT_NOFILE), the rest is left for the scans and for the user
+    static size_t GetDefaultLimit() noexcept {
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY)
+            return MAX_LIMIT;
+        return std::min<size_t>(limit.rlim_cur / 2, MAX_LIMIT);
+    }
+
+    // return: the quantity of the kept descriptors of all walkers
+    static size_t GetKept() noexcept {
+        return _kept.load(std::memory_order_relaxed);
+    }
+
+    // return: true if the place is taken, it is given back by Release-method
+    bool TryAcquire() const noexcept {
+        if (_kept.fetch_add(1, std::memory_order_relaxed) < _limit)
+            return true;
+        _kept.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    static void Release() noexcept {
+        _kept.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // brief: shares the descriptor of the catalog which is enumerated now with its sub catalogs
+    // return: the descriptor which keeps the place in the limit until its last owner is destroyed, or nullptr if the limit is reached
+    SharedFileDescriptor TryKeep(const SharedFileDescriptor& current_fd) const {
+        if (!TryAcquire())
+            return nullptr;
+
+        struct Place {
+            SharedFileDescriptor fd;
+            ~Place() {
+                Release();
+            }
+        };
+        const auto place = std::make_shared<Place>();
+        place->fd = current_fd;
+        // NOTE: the aliasing pointer owns the place and points to the descriptor
+        return SharedFileDescriptor(place, place->fd.get());
+    }
+};
+
+// brief: the entry of catalog with the metadata collected during the scan of the catalog (see RecursiveWalking::WalkInBatches)
+struct EntryInfo {
+    std::string_view name;
+    uint64_t inode;
+    // NOTE: d_type-value of the entry (DT_REG, DT_DIR, DT_LNK, ...), but is_directory follows the symbolic links
+    uint8_t type;
+    bool is_directory;
+    // NOTE: the fields below are filled only if the metadata is requested
+    uint32_t mode;
+    uint32_t links;
+    // NOTE: the device of the entry, the pair of device and inode identifies the file among its hard links
+    uint64_t device;
+    uint64_t size;
+    uint64_t blocks;
+    int64_t modification_time_sec;
+    uint32_t modification_time_nsec;
+
+    static constexpr unsigned int STATX_MASK{ STATX_TYPE | STATX_MODE | STATX_NLINK | STATX_SIZE | STATX_BLOCKS | STATX_MTIME };
+    static constexpr int STATX_FLAGS{ AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT };
+
+    // brief: fills the metadata by statx-syscall, the symbolic links are not followed
+    // return: false if statx is failed, in this case the metadata stays zero
+    bool FillMetadata(const int dir_fd, const char* const entry_name) noexcept {
+        struct statx entry_statx;
+        if (::statx(dir_fd, entry_name, STATX_FLAGS, STATX_MASK, &entry_statx) != 0)
+            return false;
+
+        SetMetadata(entry_statx);
+        return true;
+    }
+
+    // brief: fills the metadata by the result of statx which is done elsewhere (see DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_IO_URING>)
+    void SetMetadata(const struct statx& entry_statx) noexcept {
+        mode = entry_statx.stx_mode;
+        links = entry_statx.stx_nlink;
+        device = makedev(entry_statx.stx_dev_major, entry_statx.stx_dev_minor);
+        size = entry_statx.stx_size;
+        blocks = entry_statx.stx_blocks;
+        modification_time_sec = entry_statx.stx_mtime.tv_sec;
+        modification_time_nsec = entry_statx.stx_mtime.tv_nsec;
+        if (type == DT_UNKNOWN)
+            type = static_cast<uint8_t>(IFTODT(mode));
+    }
+};
+
+// brief: non-owning view of the contiguous entries of one catalog
+struct EntriesView {
+    const EntryInfo* data;
+    size_t size;
+
+    const EntryInfo* begin() const noexcept {
+        return data;
+    }
+
+    const EntryInfo* end() const noexcept {
+        return data + size;
+    }
+
+    const EntryInfo& operator[](const size_t index) const noexcept {
+        return data[index];
+    }
+};
+
+template<>
+struct DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_GETDENTS> {
+    using DirectoryType = fs::path;
+
+    static constexpr size_t BUFFER_SIZE{ 64 * 1024 };
+    static constexpr int OPEN_FLAGS{ O_RDONLY | O_DIRECTORY | O_CLOEXEC };
+
+    // NOTE: the layout of records returned by getdents64-syscall
+    struct LinuxDirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[1];
+    };
+
+    // brief: the entry of catalog which builds own full path only on demand
+    class Entry {
+        const fs::path& _parent;
+        const LinuxDirent64& _dirent;
+        int _dir_fd;
+        bool _is_directory;
+
+        public:
+        Entry(const fs::path& parent, const LinuxDirent64& dirent, const int dir_fd, const bool is_directory) noexcept
+            : _parent{ parent }
+            , _dirent{ dirent }
+            , _dir_fd{ dir_fd }
+            , _is_directory{ is_directory } {}
+
+        bool is_directory() const noexcept {
+            return _is_directory;
+        }
+
+        std::string_view name() const noexcept {
+            return _dirent.d_name;
+        }
+
+        uint64_t inode() const noexcept {
+            return _dirent.d_ino;
+        }
+
+        uint8_t type() const noexcept {
+            return _dirent.d_type;
+        }
+
+        // brief: the descriptor of the parent catalog which is valid during the enumeration
+        int dir_fd() const noexcept {
+            return _dir_fd;
+        }
+
+        fs::path path() const {
+            return _parent / _dirent.d_name;
+        }
+    };
+    using EntryType = Entry;
+
+    template<class EntryType>
+    static DirectoryType ToDirectory(const EntryType& entry) {
+        return entry.path();
+    }
+
+    static const fs::path& GetPath(const DirectoryType& directory) noexcept {
+        return directory;
+    }
+
+    // brief: checks the type of the entry; the symbolic links are followed as fs::directory_entry::is_directory does
+    static bool IsDirectory(const int dir_fd, const LinuxDirent64& dirent) noexcept {
+        switch (dirent.d_type) {
+            case DT_DIR:
+                return true;
+            case DT_LNK:
+            case DT_UNKNOWN: {
+                struct stat entry_stat;
+                return ::fstatat(dir_fd, dirent.d_name, &entry_stat, 0) == 0 && S_ISDIR(entry_stat.st_mode);
+            }
+            default:
+                return false;
+        }
+    }
+
+    // NOTE: the attempts to open the catalog while the limit of descriptors is reached (see Open-method)
+    static constexpr size_t OPEN_ATTEMPTS{ 100 };
+
+    // brief: calls the open-function, the opening which is failed by the limit of descriptors is repeated after a pause,
+    // | because the other walkers close their descriptors when they finish their catalogs
+    // return: the descriptor which is not valid if all attempts are failed, errno keeps the error of the last attempt
+    template<class OpenType>
+    static FileDescriptor Open(OpenType&& open) {
+        int fd = open();
+        for (size_t attempt{ 1 }; fd < 0 && (errno == EMFILE || errno == ENFILE) && attempt < OPEN_ATTEMPTS; ++attempt) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            fd = open();
+        }
+        return FileDescriptor{ fd };
+    }
+
+    // brief: throws the error of opening of the catalog, except the errors of access and of the limit of descriptors that are skipped
+    // note: the exception in the walker terminates the process, so the catalog which is not opened after all attempts of Open-method is skipped
+    static void SkipOrThrow(const int error, const fs::path& directory) {
+        if (error != EACCES && error != EMFILE && error != ENFILE)
+            throw fs::filesystem_error("cannot open directory", directory, std::error_code(error, std::generic_category()));
+    }
+
+    // brief: calls the action(dirent, is_directory) for every entry of the catalog which is opened as dir_fd
+    template<class ActionType>
+    static void ReadEntries(const int dir_fd, ActionType&& action) {
+        // NOTE: the buffer is taken from the thread cache for the time of the enumeration, so nested enumerations on one thread are safe
+        thread_local std::unique_ptr<char[]> cached_buffer{};
+        std::unique_ptr<char[]> buffer{ cached_buffer ? std::move(cached_buffer) : std::make_unique<char[]>(BUFFER_SIZE) };
+
+        for (long read_size; (read_size = ::syscall(SYS_getdents64, dir_fd, buffer.get(), BUFFER_SIZE)) > 0;) {
+            for (long offset{ 0 }; offset < read_size;) {
+                const LinuxDirent64& dirent = *reinterpret_cast<const LinuxDirent64*>(buffer.get() + offset);
+                offset += dirent.d_reclen;
+
+                const char* name = dirent.d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                    continue;
+
+                action(dirent, IsDirectory(dir_fd, dirent));
+            }
+        }
+        cached_buffer = std::move(buffer);
+    }
+
+    template<class ActionType>
+    static void ForEach(const DirectoryType& directory, ActionType&& action) {
+        const FileDescriptor dir_fd = Open([&]() { return ::open(directory.c_str(), OPEN_FLAGS); });
+        if (!dir_fd.is_valid())
+            return SkipOrThrow(errno, directory);
+
+        ReadEntries(dir_fd.get(), [&](const LinuxDirent64& dirent, const bool is_directory) { action(Entry(directory, dirent, dir_fd.get(), is_directory)); });
+    }
+};
+
+template<>
+class DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_OPENAT> {
+    using GetdentsEnumerator = DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_GETDENTS>;
+    using SharedFileDescriptor = std::shared_ptr<FileDescriptor>;
+
+    public:
+    // NOTE: the catalog keeps the descriptor of its parent until it is opened, so the descriptor of parent is closed when all its sub catalogs are opened;
+    // | the descriptor is not kept if the limit of kept descriptors is reached (see KeptDescriptors-class)
+    struct DirectoryType {
+        const PathNode* node;
+        SharedFileDescriptor parent_fd;
+    };
+
+    // brief: the entry of catalog which builds own full path only on demand
+    class Entry {
+        using LinuxDirent64 = GetdentsEnumerator::LinuxDirent64;
+
+        const PathNode* _parent;
+        const LinuxDirent64& _dirent;
+        std::string_view _name;
+        int _dir_fd;
+        bool _is_directory;
+
+        public:
+        Entry(const PathNode* parent, const LinuxDirent64& dirent, const int dir_fd, const bool is_directory) noexcept
+            : _parent{ parent }
+            , _dirent{ dirent }
+            , _name{ dirent.d_name }
+            , _dir_fd{ dir_fd }
+            , _is_directory{ is_directory } {}
+
+        bool is_directory() const noexcept {
+            return _is_directory;
+        }
+
+        std::string_view name() const noexcept {
+            return _name;
+        }
+
+        uint64_t inode() const noexcept {
+            return _dirent.d_ino;
+        }
+
+        uint8_t type() const noexcept {
+            return _dirent.d_type;
+        }
+
+        // brief: the descriptor of the parent catalog which is valid during the enumeration
+        int dir_fd() const noexcept {
+            return _dir_fd;
+        }
+
+        const PathNode* parent() const noexcept {
+            return _parent;
+        }
+
+        fs::path path() const {
+            return _parent->GetPath() / _name;
+        }
+    };
+    using EntryType = Entry;
+
+    private:
+    PathArena _arena{};
+    KeptDescriptors _kept_descriptors{};
+    // NOTE: the descriptor of the catalog which is enumerated now
+    SharedFileDescriptor _current_fd{};
+    // NOTE: the descriptor of the catalog which is enumerated now that is kept by its sub catalogs, it is taken at the first sub catalog
+    SharedFileDescriptor _kept_fd{};
+    bool _is_kept_fd_taken{};
+
+    public:
+    DirectoryType ToDirectory(const Entry& entry) {
+        if (!_is_kept_fd_taken) {
+            _kept_fd = _kept_descriptors.TryKeep(_current_fd);
+            _is_kept_fd_taken = true;
+        }
+        return { _arena.Add(entry.parent(), entry.name()), _kept_fd };
+    }
+
+    DirectoryType ToDirectory(const fs::directory_entry& initial_entry) {
+        std::string_view initial_path{ initial_entry.path().native() };
+        while (initial_path.size() > 1 && initial_path.back() == fs::path::preferred_separator)
+            initial_path.remove_suffix(1);
+        return { _arena.Add(nullptr, initial_path), nullptr };
+    }
+
+    static fs::path GetPath(const DirectoryType& directory) {
+        return directory.node->GetPath();
+    }
+
+    template<class ActionType>
+    void ForEach(const DirectoryType& directory, ActionType&& action) {
+        FileDescriptor dir_fd{ directory.parent_fd ? ::openat(directory.parent_fd->get(), directory.node->name(), GetdentsEnumerator::OPEN_FLAGS) : -1 };
+        // NOTE: the catalog is opened by full path if it is initial catalog, if its parent is not kept or if the limit of opened descriptors is reached
+        if (!dir_fd.is_valid() && (!directory.parent_fd || errno == EMFILE || errno == ENFILE))
+            dir_fd = GetdentsEnumerator::Open([&]() { return ::open(GetPath(directory).c_str(), GetdentsEnumerator::OPEN_FLAGS); });
+        if (!dir_fd.is_valid())
+            return GetdentsEnumerator::SkipOrThrow(errno, GetPath(directory));
+
+        _current_fd = std::make_shared<FileDescriptor>(std::move(dir_fd));
+        _kept_fd.reset();
+        _is_kept_fd_taken = false;
+        GetdentsEnumerator::ReadEntries(_current_fd->get(), [&](const GetdentsEnumerator::LinuxDirent64& dirent, const bool is_directory) {
+            action(Entry(directory.node, dirent, _current_fd->get(), is_directory));
+        });
+        _kept_fd.reset();
+        _current_fd.reset();
+    }
+};
+
+template<>
+class DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_IO_URING> {
+    using GetdentsEnumerator = DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_GETDENTS>;
+    using SharedFileDescriptor = std::shared_ptr<FileDescriptor>;
+
+    // brief: the opening of the sub catalog which is started in advance by the walker which has found it
+    // note: the opening is completed by the reaping of the ring of the walker which has started it, but the catalog may be taken by any walker,
+    // | so the descriptor is passed through the atomic result; if the catalog is taken before the reaping, it is opened synchronously
+    // | and the late descriptor is closed by the reaping walker
+    struct PendingOpen {
+        static constexpr int PENDING{ INT_MIN };
+        static constexpr int TAKEN{ INT_MIN + 1 };
+
+        // NOTE: the descriptor of the opened catalog, -errno of the failed opening, PENDING or TAKEN
+        std::atomic_int result{ PENDING };
+        // NOTE: the kernel resolves the name relative to the parent when it executes the operation, so the parent is kept opened until the reaping
+        SharedFileDescriptor parent_fd;
+        // NOTE: the counter of the opened, but not taken descriptors of the walker which has started the opening
+        std::shared_ptr<std::atomic_size_t> prefetched;
+
+        // NOTE: the opening takes the place in the limit of kept descriptors from the start until its descriptor is taken or closed
+        void _Finish() noexcept {
+            --*prefetched;
+            KeptDescriptors::Release();
+        }
+
+        PendingOpen() = default;
+        PendingOpen(const PendingOpen&) = delete;
+        PendingOpen& operator=(const PendingOpen&) = delete;
+
+        // NOTE: the catalog which is never taken (e.g. the walk is stopped by an exception) still owns its opened descriptor
+        ~PendingOpen() {
+            if (const int fd = result.load(std::memory_order_acquire); fd >= 0) {
+                ::close(fd);
+                _Finish();
+            }
+        }
+
+        // return: the descriptor of the catalog or -1 if the opening is not completed or is failed
+        int Take() noexcept {
+            const int fd = result.exchange(TAKEN, std::memory_order_acq_rel);
+            if (fd < 0)
+                return -1;
+            _Finish();
+            return fd;
+        }
+
+        // brief: publishes the result of the operation, the descriptor of the catalog which is already taken is closed
+        void Complete(const int operation_result) noexcept {
+            int expected{ PENDING };
+            if (operation_result >= 0 && result.compare_exchange_strong(expected, operation_result, std::memory_order_acq_rel))
+                return;
+            if (operation_result >= 0)
+                ::close(operation_result);
+            else
+                result.store(operation_result, std::memory_order_release);
+            _Finish();
+        }
+    };
+
+    // NOTE: the low bit of user_data of the operation separates statx (its index in the catalog) from openat (the pointer to PendingOpen)
+    static constexpr uint64_t STATX_TAG{ 1 };
+
+    public:
+    // NOTE: the catalog keeps the descriptor of its parent until it is opened, if the limit allows it (see DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_OPENAT>)
+    struct DirectoryType {
+        const PathNode* node;
+        SharedFileDescriptor parent_fd;
+        std::shared_ptr<PendingOpen> pending_open;
+    };
+
+    using Entry = DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_OPENAT>::Entry;
+    using EntryType = Entry;
+
+    // brief: sets the quantity of asynchronous operations of every walker, the new value is used by the walkers which are created after the call
+    // note: it also limits the quantity of descriptors which are opened in advance by one walker
+    static void SetQueueDepth(const unsigned queue_depth) noexcept {
+        _queue_depth.store(std::max(queue_depth, 1u), std::memory_order_relaxed);
+    }
+
+    static unsigned GetQueueDepth() noexcept {
+        return _queue_depth.load(std::memory_order_relaxed);
+    }
+
+    private:
+    static inline std::atomic<unsigned> _queue_depth{ 64 };
+
+    PathArena _arena{};
+    KeptDescriptors _kept_descriptors{};
+    SharedFileDescriptor _current_fd{};
+    // NOTE: the descriptor of the catalog which is enumerated now that is kept by its sub catalogs, it is taken at the first sub catalog
+    SharedFileDescriptor _kept_fd{};
+    bool _is_kept_fd_taken{};
+    IoUring _ring{ GetQueueDepth() };
+    size_t _prefetch_limit{ GetQueueDepth() };
+    std::shared_ptr<std::atomic_size_t> _prefetched{ std::make_shared<std::atomic_size_t>() };
+    std::vector<struct statx> _statx_buffers{};
+
+    // brief: makes the action for the completions of the ring, the statx_action(index, result) is called for statx-operations
+    // note: the opening which is canceled after the error of the submission fails, so the catalog is opened synchronously
+    template<class StatxActionType>
+    static auto _MakeCompletionAction(StatxActionType& statx_action) {
+        return [&statx_action](const uint64_t user_data, const int result) {
+            if (user_data & STATX_TAG) {
+                statx_action(static_cast<size_t>(user_data >> 1), result);
+            } else {
+                const std::unique_ptr<std::shared_ptr<PendingOpen>> pending_open{ reinterpret_cast<std::shared_ptr<PendingOpen>*>(user_data) };
+                (*pending_open)->Complete(result);
+            }
+        };
+    }
+
+    template<class StatxActionType>
+    void _Reap(StatxActionType&& statx_action) {
+        _ring.Reap(_MakeCompletionAction(statx_action));
+    }
+
+    void _Reap() {
+        _Reap([](size_t, int) {});
+    }
+
+    // brief: starts the opening of the sub catalog if the ring, the limit of descriptors which are opened in advance
+    // | and the limit of kept descriptors (see KeptDescriptors-class) allow it
+    std::shared_ptr<PendingOpen> _PrefetchOpen(const PathNode* const node) {
+        if (_prefetched->load(std::memory_order_relaxed) >= _prefetch_limit || !_kept_descriptors.TryAcquire())
+            return nullptr;
+        io_uring_sqe* const sqe = _ring.PrepareSqe();
+        if (!sqe) {
+            KeptDescriptors::Release();
+            return nullptr;
+        }
+
+        auto pending_open = std::make_shared<PendingOpen>();
+        pending_open->parent_fd = _current_fd;
+        pending_open->prefetched = _prefetched;
+        ++*_prefetched;
+
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = _current_fd->get();
+        sqe->addr = reinterpret_cast<uint64_t>(node->name());
+        sqe->open_flags = GetdentsEnumerator::OPEN_FLAGS;
+        // NOTE: the ring owns one reference to the operation until its completion is reaped
+        sqe->user_data = reinterpret_cast<uint64_t>(new std::shared_ptr<PendingOpen>(pending_open));
+        return pending_open;
+    }
+
+    public:
+    DirectoryEnumerator() = default;
+    DirectoryEnumerator(const DirectoryEnumerator&) = delete;
+    DirectoryEnumerator& operator=(const DirectoryEnumerator&) = delete;
+
+    // NOTE: the kernel writes into the buffers of the operations, so all of them are completed before the destruction
+    ~DirectoryEnumerator() {
+        auto statx_action = [](size_t, int) {};
+        _ring.WaitAll(_MakeCompletionAction(statx_action));
+    }
+
+    DirectoryType ToDirectory(const Entry& entry) {
+        if (!_is_kept_fd_taken) {
+            _kept_fd = _kept_descriptors.TryKeep(_current_fd);
+            _is_kept_fd_taken = true;
+        }
+        const PathNode* const node = _arena.Add(entry.parent(), entry.name());
+        return { node, _kept_fd, _PrefetchOpen(node) };
+    }
+
+    DirectoryType ToDirectory(const fs::directory_entry& initial_entry) {
+        std::string_view initial_path{ initial_entry.path().native() };
+        while (initial_path.size() > 1 && initial_path.back() == fs::path::preferred_separator)
+            initial_path.remove_suffix(1);
+        return { _arena.Add(nullptr, initial_path), nullptr, nullptr };
+    }
+
+    static fs::path GetPath(const DirectoryType& directory) {
+        return directory.node->GetPath();
+    }
+
+    // brief: calls the action for every entry of the catalog and the after_scan(dir_fd) when all entries are read
+    // note: the openings of the found sub catalogs are given to the kernel by one syscall after the scan
+    template<class ActionType, class AfterScanType>
+    void ForEach(const DirectoryType& directory, ActionType&& action, AfterScanType&& after_scan) {
+        _Reap();
+        FileDescriptor dir_fd{ directory.pending_open ? directory.pending_open->Take() : -1 };
+        if (!dir_fd.is_valid() && directory.parent_fd)
+            dir_fd = FileDescriptor{ ::openat(directory.parent_fd->get(), directory.node->name(), GetdentsEnumerator::OPEN_FLAGS) };
+        // NOTE: the catalog is opened by full path if it is initial catalog, if its parent is not kept or if the limit of opened descriptors is reached
+        if (!dir_fd.is_valid() && (!directory.parent_fd || errno == EMFILE || errno == ENFILE))
+            dir_fd = GetdentsEnumerator::Open([&]() { return ::open(GetPath(directory).c_str(), GetdentsEnumerator::OPEN_FLAGS); });
+        if (!dir_fd.is_valid())
+            return GetdentsEnumerator::SkipOrThrow(errno, GetPath(directory));
+
+        _current_fd = std::make_shared<FileDescriptor>(std::move(dir_fd));
+        _kept_fd.reset();
+        _is_kept_fd_taken = false;
+        GetdentsEnumerator::ReadEntries(_current_fd->get(), [&](const GetdentsEnumerator::LinuxDirent64& dirent, const bool is_directory) {
+            action(Entry(directory.node, dirent, _current_fd->get(), is_directory));
+        });
+        after_scan(_current_fd->get());
+        _kept_fd.reset();
+        _current_fd.reset();
+        _ring.Submit();
+    }
+
+    template<class ActionType>
+    void ForEach(const DirectoryType& directory, ActionType&& action) {
+        ForEach(directory, std::forward<ActionType>(action), [](int) {});
+    }
+
+    // brief: fills the metadata of the entries of the catalog by statx-operations which are running in parallel (see EntryInfo::FillMetadata)
+    // param: dir_fd - the descriptor of the catalog which is valid during the call
+    // note: the names of the entries must be terminated by zero
+    void FillMetadata(const int dir_fd, EntryInfo* const entries, const size_t entries_quantity) {
+        if (!_ring.IsValid()) {
+            for (size_t i{ 0 }; i < entries_quantity; ++i)
+                entries[i].FillMetadata(dir_fd, entries[i].name.data());
+            return;
+        }
+
+        if (_statx_buffers.size() < entries_quantity)
+            _statx_buffers.resize(entries_quantity);
+        size_t finished{ 0 };
+        // NOTE: the operation which is canceled after the error of the submission is done synchronously
+        auto statx_action = [&](const size_t index, const int result) {
+            if (result == 0)
+                entries[index].SetMetadata(_statx_buffers[index]);
+            else if (result == -ECANCELED)
+                entries[index].FillMetadata(dir_fd, entries[index].name.data());
+            ++finished;
+        };
+        for (size_t next{ 0 }; finished < entries_quantity;) {
+            for (io_uring_sqe* sqe; next < entries_quantity && (sqe = _ring.PrepareSqe()); ++next) {
+                sqe->opcode = IORING_OP_STATX;
+                sqe->fd = dir_fd;
+                sqe->addr = reinterpret_cast<uint64_t>(entries[next].name.data());
+                sqe->len = EntryInfo::STATX_MASK;
+                sqe->statx_flags = EntryInfo::STATX_FLAGS;
+                sqe->off = reinterpret_cast<uint64_t>(&_statx_buffers[next]);
+                sqe->user_data = (static_cast<uint64_t>(next) << 1) | STATX_TAG;
+            }
+            if (_ring.Submit(1) != 0) {
+                // NOTE: the operations in the kernel are waited for, because the kernel writes into their buffers
+                _ring.WaitAll(_MakeCompletionAction(statx_action));
+                for (; next < entries_quantity; ++next)
+                    entries[next].FillMetadata(dir_fd, entries[next].name.data());
+                return;
+            }
+            _Reap(statx_action);
+        }
+    }
+};
+#endif
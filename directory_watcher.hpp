@@ -0,0 +1,340 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "walk_index.hpp"
+#include "directory_enumerator.hpp"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+
+// brief: the event which is given to the actions of DirectoryWatcher-class
+// note: EXISTING - the entry is found by the initial walk;
+// | CREATED, DELETED - the entry is created or deleted (also the entries of created, deleted or moved sub catalogs);
+// | MOVED_FROM, MOVED_TO - the entry is moved out of its catalog or into it.
+enum class WATCH_EVENT : uint8_t { EXISTING, CREATED, DELETED, MOVED_FROM, MOVED_TO };
+
+// brief: keeps the tree of OS catalogs in the memory up to date by inotify after the initial walk and gives the changes to the actions
+// t-param: WalkingType - the type of RecursiveWalking-class which is used for the initial walk and for the walks of new sub catalogs
+// note: the catalogs are watched from their finding, so the entries created during the walk are not lost (the repeated finding is ignored)
+// note: the actions are called by walkers during the initial walk and by the thread which calls Process-method after it
+template<class WalkingType>
+class DirectoryWatcher {
+    public:
+    using ActionType = std::function<void(size_t /*deep*/, const fs::path& /*full_path*/, WATCH_EVENT /*event*/)>;
+    using OptActionType = std::optional<ActionType>;
+
+    private:
+    static constexpr uint32_t WATCH_MASK{ IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK };
+    static constexpr size_t BUFFER_SIZE{ 64 * 1024 };
+    // NOTE: the catalog which is changed in this interval before its scan may be changed again without changing of its stamp
+    static constexpr int64_t RACY_INTERVAL{ 2'000'000'000 };
+
+    struct WatchedDirectory {
+        size_t deep;
+        int watch;
+        DirectoryStamp stamp;
+        int64_t scan_time;
+        std::unordered_map<std::string, bool /*is_directory*/> entries;
+    };
+
+    struct PendingEvent {
+        size_t deep;
+        fs::path path;
+        WATCH_EVENT event;
+        bool is_directory;
+        bool is_dropped;
+    };
+
+    size_t _deep;
+    size_t _thread_quantity;
+    OptActionType _action_with_file;
+    OptActionType _action_with_dir;
+    FileDescriptor _inotify;
+    bool _is_initial_walk{ true };
+
+    std::mutex _tree_mutex{};
+    std::unordered_map<std::string, WatchedDirectory> _directories{};
+    std::unordered_map<int, std::string> _paths_by_watch{};
+
+    std::mutex _pending_mutex{};
+    std::vector<PendingEvent> _pending_events{};
+    std::unordered_map<std::string, size_t> _pending_creations{};
+
+    static int64_t _GetTime() noexcept {
+        struct timespec time;
+        ::clock_gettime(CLOCK_REALTIME, &time);
+        return static_cast<int64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+    }
+
+    // brief: gives the event to the action right away during the initial walk, or keeps it until the end of the current batch of events
+    // note: the creation and the deletion of the same entry inside one batch annihilate each other
+    void _Notify(const size_t deep, fs::path&& path, const WATCH_EVENT event, const bool is_directory) {
+        if (_is_initial_walk) {
+            if (const OptActionType& action = is_directory ? _action_with_dir : _action_with_file; action.has_value())
+                (*action)(deep, path, event);
+            return;
+        }
+
+        std::lock_guard lock(_pending_mutex);
+        if (event == WATCH_EVENT::DELETED || event == WATCH_EVENT::MOVED_FROM) {
+            if (auto creation = _pending_creations.find(path.string()); creation != _pending_creations.end()) {
+                _pending_events[creation->second].is_dropped = true;
+                _pending_creations.erase(creation);
+                return;
+            }
+        } else {
+            _pending_creations[path.string()] = _pending_events.size();
+        }
+        _pending_events.push_back(PendingEvent{ deep, std::move(path), event, is_directory, false });
+    }
+
+    // brief: starts watching of the catalog, must be called before the scan of the catalog
+    // note: if the watch can not be added (for example, the limit of watches is reached), the catalog is kept in the tree, but its changes are found only by rescan
+    void _RegisterDirectory(const fs::path& path, const size_t deep) {
+        const int watch = ::inotify_add_watch(_inotify.get(), path.c_str(), WATCH_MASK);
+        WatchedDirectory directory{ deep, watch, DirectoryStamp::Get(path).value_or(DirectoryStamp{}), _GetTime(), {} };
+        std::lock_guard lock(_tree_mutex);
+        _directories.insert_or_assign(path.string(), std::move(directory));
+        if (watch >= 0)
+            _paths_by_watch.insert_or_assign(watch, path.string());
+    }
+
+    // brief: adds the entry to its catalog in the memory
+    // return: false if the entry is already known or the catalog is not watched
+    bool _AddToTree(const fs::path& path, const bool is_directory) {
+        std::lock_guard lock(_tree_mutex);
+        auto parent = _directories.find(path.parent_path().string());
+        return parent != _directories.end() && parent->second.entries.emplace(path.filename().string(), is_directory).second;
+    }
+
+    // brief: walks in the new catalog, registers all its sub catalogs and gives all its entries to the actions
+    void _WalkDirectory(const fs::path& path, const size_t deep, const WATCH_EVENT event) {
+        _RegisterDirectory(path, deep);
+        auto on_file = [&](size_t sub_deep, const fs::path& sub_path) {
+            if (_AddToTree(sub_path, false))
+                _Notify(deep + sub_deep, fs::path(sub_path), event, false);
+        };
+        auto on_dir = [&](size_t sub_deep, const fs::path& sub_path) {
+            _RegisterDirectory(sub_path, deep + sub_deep + 1);
+            if (_AddToTree(sub_path, true))
+                _Notify(deep + sub_deep, fs::path(sub_path), event, true);
+        };
+        WalkingType(_deep == SIZE_MAX ? SIZE_MAX : _deep - deep, _thread_quantity).WalkIn(path, on_file, on_dir);
+    }
+
+    void _AddEntry(const fs::path& parent, const std::string& name, const bool is_directory, const WATCH_EVENT event) {
+        size_t deep{};
+        {
+            std::lock_guard lock(_tree_mutex);
+            auto directory = _directories.find(parent.string());
+            if (directory == _directories.end())
+                return;
+            deep = directory->second.deep;
+            // NOTE: the catalogs deeper than the limit of the walk are ignored like by the walk
+            if (is_directory && deep >= _deep)
+                return;
+            if (!directory->second.entries.emplace(name, is_directory).second)
+                return;
+        }
+
+        const fs::path path = parent / name;
+        _Notify(deep, fs::path(path), event, is_directory);
+        if (is_directory)
+            _WalkDirectory(path, deep + 1, WATCH_EVENT::CREATED);
+    }
+
+    void _RemoveEntry(const fs::path& parent, const std::string& name, const WATCH_EVENT event) {
+        size_t deep{};
+        bool is_directory{};
+        {
+            std::lock_guard lock(_tree_mutex);
+            auto directory = _directories.find(parent.string());
+            if (directory == _directories.end())
+                return;
+            auto entry = directory->second.entries.find(name);
+            if (entry == directory->second.entries.end())
+                return;
+            deep = directory->second.deep;
+            is_directory = entry->second;
+            directory->second.entries.erase(entry);
+        }
+
+        fs::path path = parent / name;
+        if (is_directory)
+            _RemoveDirectory(path);
+        _Notify(deep, std::move(path), event, is_directory);
+    }
+
+    // brief: forgets the catalog and all its sub catalogs, the entries of them are given to the actions as deleted
+    void _RemoveDirectory(const fs::path& path) {
+        std::optional<WatchedDirectory> directory{};
+        {
+            std::lock_guard lock(_tree_mutex);
+            auto node = _directories.find(path.string());
+            if (node == _directories.end())
+                return;
+            directory.emplace(std::move(node->second));
+            _directories.erase(node);
+            _paths_by_watch.erase(directory->watch);
+        }
+        // NOTE: the watch of the deleted catalog is already removed by the system, but the watch of the moved catalog must be removed here
+        if (directory->watch >= 0)
+            ::inotify_rm_watch(_inotify.get(), directory->watch);
+
+        for (auto& [name, is_directory] : directory->entries) {
+            fs::path sub_path = path / name;
+            if (is_directory)
+                _RemoveDirectory(sub_path);
+            _Notify(directory->deep, std::move(sub_path), WATCH_EVENT::DELETED, is_directory);
+        }
+    }
+
+    // brief: after the overflow of the queue of inotify rescans only the catalogs which stamps are changed since their previous scan
+    // | and gives the differences to the actions
+    void _Rescan() {
+        std::vector<std::string> paths{};
+        {
+            std::lock_guard lock(_tree_mutex);
+            paths.reserve(_directories.size());
+            for (const auto& [path, directory] : _directories)
+                paths.emplace_back(path);
+        }
+
+        for (const std::string& path : paths) {
+            const std::optional<DirectoryStamp> stamp{ DirectoryStamp::Get(path) };
+            // NOTE: the catalog which does not exist anymore is removed by the rescan of its parent
+            if (!stamp.has_value())
+                continue;
+
+            std::unordered_map<std::string, bool> previous_entries{};
+            {
+                std::lock_guard lock(_tree_mutex);
+                auto directory = _directories.find(path);
+                if (directory == _directories.end())
+                    continue;
+                WatchedDirectory& node = directory->second;
+                if (node.stamp == stamp.value() && node.stamp.modification_time + RACY_INTERVAL < node.scan_time)
+                    continue;
+                node.stamp = stamp.value();
+                node.scan_time = _GetTime();
+                previous_entries = node.entries;
+            }
+
+            std::unordered_map<std::string, bool> current_entries{};
+            std::error_code error{};
+            for (const fs::directory_entry& entry : fs::directory_iterator(path, fs::directory_options::skip_permission_denied, error))
+                current_entries.emplace(entry.path().filename().string(), entry.is_directory());
+
+            for (const auto& [name, is_directory] : previous_entries)
+                if (auto current = current_entries.find(name); current == current_entries.end() || current->second != is_directory)
+                    _RemoveEntry(path, name, WATCH_EVENT::DELETED);
+            for (const auto& [name, is_directory] : current_entries)
+                _AddEntry(path, name, is_directory, WATCH_EVENT::CREATED);
+        }
+    }
+
+    void _Handle(const struct inotify_event& event) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            _Rescan();
+            return;
+        }
+
+        fs::path parent{};
+        {
+            std::lock_guard lock(_tree_mutex);
+            auto path = _paths_by_watch.find(event.wd);
+            if (path == _paths_by_watch.end())
+                return;
+            if (event.mask & IN_IGNORED) {
+                _paths_by_watch.erase(path);
+                return;
+            }
+            parent = path->second;
+        }
+        if (!event.len)
+            return;
+
+        const std::string name{ event.name };
+        const bool is_directory = event.mask & IN_ISDIR;
+        if (event.mask & IN_CREATE)
+            _AddEntry(parent, name, is_directory, WATCH_EVENT::CREATED);
+        else if (event.mask & IN_MOVED_TO)
+            _AddEntry(parent, name, is_directory, WATCH_EVENT::MOVED_TO);
+        else if (event.mask & IN_DELETE)
+            _RemoveEntry(parent, name, WATCH_EVENT::DELETED);
+        else if (event.mask & IN_MOVED_FROM)
+            _RemoveEntry(parent, name, WATCH_EVENT::MOVED_FROM);
+    }
+
+    public:
+#pragma region constructors / destructor
+    // brief: registers the catalog and walks in it, the found entries are given to the actions as WATCH_EVENT::EXISTING
+    DirectoryWatcher(
+        const fs::path& catalog,
+        const size_t deep,
+        const size_t thread_quantity,
+        const OptActionType& action_with_file = std::nullopt,
+        const OptActionType& action_with_dir = std::nullopt)
+        : _deep{ deep }
+        , _thread_quantity{ thread_quantity }
+        , _action_with_file{ action_with_file }
+        , _action_with_dir{ action_with_dir }
+        , _inotify{ ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) } {
+        if (!_inotify.is_valid())
+            throw std::exception("inotify instance can not be created");
+        if (!fs::is_directory(catalog))
+            throw std::exception("initial directory is not OS catalog");
+
+        _WalkDirectory(catalog, 0, WATCH_EVENT::EXISTING);
+        _is_initial_walk = false;
+    }
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+#pragma endregion constructors / destructor
+
+    // brief: waits for the changes of the watched tree and gives them to the actions
+    // param: timeout - the limit of the waiting of the first change
+    // param: latency - the time during which the changes are collected into one batch after the first change
+    // return: quantity of the events given to the actions
+    size_t Process(const std::chrono::milliseconds timeout = std::chrono::milliseconds(1000), const std::chrono::milliseconds latency = std::chrono::milliseconds(10)) {
+        struct pollfd descriptor{ _inotify.get(), POLLIN, 0 };
+        if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0)
+            return 0;
+        std::this_thread::sleep_for(latency);
+
+        // NOTE: the buffer is aligned like inotify_event, because the events are read from it in place
+        alignas(struct inotify_event) char buffer[BUFFER_SIZE];
+        ssize_t size{};
+        while ((size = ::read(_inotify.get(), buffer, BUFFER_SIZE)) > 0) {
+            for (ssize_t offset{ 0 }; offset < size;) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+                _Handle(*event);
+                offset += sizeof(struct inotify_event) + event->len;
+            }
+        }
+
+        std::vector<PendingEvent> events{};
+        {
+            std::lock_guard lock(_pending_mutex);
+            events.swap(_pending_events);
+            _pending_creations.clear();
+        }
+        size_t result{};
+        for (PendingEvent& event : events) {
+            if (event.is_dropped)
+                continue;
+            ++result;
+            if (const OptActionType& action = event.is_directory ? _action_with_dir : _action_with_file; action.has_value())
+                (*action)(event.deep, event.path, event.event);
+        }
+        return result;
+    }
+
+    size_t GetWatchedDirectoriesQuantity() {
+        std::lock_guard lock(_tree_mutex);
+        return _directories.size();
+    }
+};
+#endif
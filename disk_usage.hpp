@@ -0,0 +1,232 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#include <unordered_set>
+
+#ifdef __linux__
+// brief: the totals of the catalog of the disk usage: the catalog itself and all entries of its subtree
+struct DiskUsageTotals {
+    // NOTE: the apparent size in bytes
+    uint64_t size{};
+    // NOTE: the allocated blocks of 512 bytes
+    uint64_t blocks{};
+    size_t files{};
+    size_t directories{};
+
+    static constexpr uint64_t BLOCK_SIZE{ 512 };
+
+    uint64_t GetDiskBytes() const noexcept {
+        return blocks * BLOCK_SIZE;
+    }
+
+    DiskUsageTotals& operator+=(const DiskUsageTotals& other) noexcept {
+        size += other.size;
+        blocks += other.blocks;
+        files += other.files;
+        directories += other.directories;
+        return *this;
+    }
+
+    bool operator==(const DiskUsageTotals& other) const noexcept {
+        return size == other.size && blocks == other.blocks && files == other.files && directories == other.directories;
+    }
+
+    bool operator!=(const DiskUsageTotals& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+// brief: the set of identities (device and inode) of files which is filled by all walkers at once
+// note: the set is divided into shards with own locks, so the walkers which meet different files rarely wait for each other;
+// | only the files with several hard links are added to the set, so the most of files never lock it
+class InodeSet {
+    static constexpr size_t SHARDS_QUANTITY{ 64 };
+
+    struct Identity {
+        uint64_t device;
+        uint64_t inode;
+
+        bool operator==(const Identity& other) const noexcept {
+            return device == other.device && inode == other.inode;
+        }
+    };
+
+    struct IdentityHash {
+        size_t operator()(const Identity& identity) const noexcept {
+            return static_cast<size_t>(identity.inode * 0x9E3779B97F4A7C15ULL ^ identity.device);
+        }
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex access_mutex{};
+        std::unordered_set<Identity, IdentityHash> identities{};
+    };
+
+    std::unique_ptr<Shard[]> _shards{ std::make_unique<Shard[]>(SHARDS_QUANTITY) };
+
+    public:
+    // return: true if the file is added first time, false if it is already met by another of its hard links
+    bool Insert(const uint64_t device, const uint64_t inode) {
+        const Identity identity{ device, inode };
+        // NOTE: the high bits of the hash select the shard, the low bits are used by the buckets of the shard
+        Shard& shard = _shards[(IdentityHash{}(identity) >> 58) % SHARDS_QUANTITY];
+        std::lock_guard lock(shard.access_mutex);
+        return shard.identities.insert(identity).second;
+    }
+
+    size_t size() const {
+        size_t result{};
+        for (size_t i{ 0 }; i < SHARDS_QUANTITY; ++i) {
+            std::lock_guard lock(_shards[i].access_mutex);
+            result += _shards[i].identities.size();
+        }
+        return result;
+    }
+};
+
+// brief: the catalog of the disk usage during the walk (see RecursiveWalking::WalkInUsage), its totals are summed by the walkers without locks
+// note: pending - the scans of the subtree which are not finished yet: one for the catalog itself and one per queued sub catalog,
+// | the subtree is finished when the last of them is finished and then its totals are added to the parent (see Complete-method)
+struct DiskUsageNode {
+    DiskUsageNode* parent;
+    std::string name;
+    // NOTE: the children are added only by the walker which scans the catalog, they are read only after the walk
+    std::vector<std::unique_ptr<DiskUsageNode>> children{};
+    std::atomic_uint64_t size{};
+    std::atomic_uint64_t blocks{};
+    std::atomic_size_t files{};
+    std::atomic_size_t directories{};
+    std::atomic_size_t pending{ 1 };
+
+    DiskUsageNode(DiskUsageNode* const node_parent, const std::string_view node_name)
+        : parent{ node_parent }
+        , name{ node_name } {}
+
+    void Add(const DiskUsageTotals& totals) noexcept {
+        size.fetch_add(totals.size, std::memory_order_relaxed);
+        blocks.fetch_add(totals.blocks, std::memory_order_relaxed);
+        files.fetch_add(totals.files, std::memory_order_relaxed);
+        directories.fetch_add(totals.directories, std::memory_order_relaxed);
+    }
+
+    DiskUsageTotals Load() const noexcept {
+        return DiskUsageTotals{
+            size.load(std::memory_order_relaxed),
+            blocks.load(std::memory_order_relaxed),
+            files.load(std::memory_order_relaxed),
+            directories.load(std::memory_order_relaxed)
+        };
+    }
+
+    // brief: reports that one scan of the subtree of the node is finished, the finished subtrees are added to their parents up to the first unfinished one
+    // note: every scan adds its totals before its report, so the last report sees all totals of the subtree
+    static void Complete(DiskUsageNode* node) noexcept {
+        while (node && node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            DiskUsageNode* const parent = node->parent;
+            if (parent)
+                parent->Add(node->Load());
+            node = parent;
+        }
+    }
+};
+
+// brief: the compact tree of totals of catalogs which is the result of the walk of the disk usage (see RecursiveWalking::WalkInUsage)
+// note: the catalogs are stored in one array by levels, the children of every catalog are stored together and are sorted by name,
+// | so the catalog is found by binary search of every name of its path; the names are stored in one string
+class DiskUsageTree {
+    public:
+    struct Node {
+        uint32_t parent;
+        uint32_t first_child;
+        uint32_t children_quantity;
+        uint32_t name_size;
+        uint64_t name_offset;
+        DiskUsageTotals totals;
+    };
+
+    static constexpr uint32_t NO_PARENT{ UINT32_MAX };
+
+    private:
+    fs::path _root_path;
+    std::vector<Node> _nodes{};
+    std::string _names{};
+
+    public:
+    // brief: moves the catalogs of the finished walk to the compact tree, the nodes of the walk are released one by one
+    DiskUsageTree(const fs::path& root_path, std::unique_ptr<DiskUsageNode> root)
+        : _root_path{ root_path } {
+        std::deque<std::unique_ptr<DiskUsageNode>> unpacked{};
+        unpacked.push_back(std::move(root));
+        _nodes.push_back(Node{ NO_PARENT, 0, 0, 0, 0, {} });
+        for (size_t index{ 0 }; !unpacked.empty(); ++index) {
+            const std::unique_ptr<DiskUsageNode> node{ std::move(unpacked.front()) };
+            unpacked.pop_front();
+            std::sort(node->children.begin(), node->children.end(), [](const auto& left, const auto& right) { return left->name < right->name; });
+            if (_nodes.size() + node->children.size() > NO_PARENT)
+                throw std::exception("too many catalogs for the tree of disk usage");
+
+            _nodes[index].first_child = static_cast<uint32_t>(_nodes.size());
+            _nodes[index].children_quantity = static_cast<uint32_t>(node->children.size());
+            _nodes[index].totals = node->Load();
+            for (std::unique_ptr<DiskUsageNode>& child : node->children) {
+                _nodes.push_back(Node{ static_cast<uint32_t>(index), 0, 0, static_cast<uint32_t>(child->name.size()), _names.size(), {} });
+                _names.append(child->name);
+                unpacked.push_back(std::move(child));
+            }
+        }
+    }
+
+    const fs::path& GetRootPath() const noexcept {
+        return _root_path;
+    }
+
+    const Node& GetRoot() const noexcept {
+        return _nodes.front();
+    }
+
+    const Node& operator[](const size_t index) const noexcept {
+        return _nodes[index];
+    }
+
+    std::string_view GetName(const size_t index) const noexcept {
+        return std::string_view(_names.data() + _nodes[index].name_offset, _nodes[index].name_size);
+    }
+
+    // return: the full path of the catalog (the root path joined with the names of the catalogs up to it)
+    fs::path GetPath(const size_t index) const {
+        std::vector<std::string_view> names{};
+        for (size_t current{ index }; current != 0; current = _nodes[current].parent)
+            names.push_back(GetName(current));
+        fs::path result{ _root_path };
+        for (auto it = names.rbegin(); it != names.rend(); ++it)
+            result.append(*it);
+        return result;
+    }
+
+    // param: relative_path - the path of the catalog relative to the root catalog, the empty path or "." is the root catalog
+    // return: the index of the catalog or std::nullopt if the catalog is not in the tree (it is not a catalog or it is deeper than the limit of deep)
+    std::optional<size_t> Find(const fs::path& relative_path) const {
+        size_t current{ 0 };
+        for (const fs::path& component : relative_path) {
+            const std::string_view name{ component.native() };
+            if (name.empty() || name == ".")
+                continue;
+
+            const Node& node = _nodes[current];
+            const auto first = _nodes.begin() + node.first_child, last = first + node.children_quantity;
+            const auto found = std::lower_bound(first, last, name, [this](const Node& child, const std::string_view value) {
+                return std::string_view(_names.data() + child.name_offset, child.name_size) < value;
+            });
+            if (found == last || GetName(static_cast<size_t>(found - _nodes.begin())) != name)
+                return std::nullopt;
+            current = static_cast<size_t>(found - _nodes.begin());
+        }
+        return current;
+    }
+
+    size_t size() const noexcept {
+        return _nodes.size();
+    }
+};
+#endif
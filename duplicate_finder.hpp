@@ -0,0 +1,194 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "fast_hash.hpp"
+#include "file_content.hpp"
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+// brief: the group of files with identical content (see DuplicateFinder-class)
+struct DuplicateGroup {
+    uint64_t size;
+    // NOTE: one path per file, the hard links of one file are not duplicates of each other
+    std::vector<fs::path> paths;
+};
+
+// brief: the result of DuplicateFinder::Find-method
+struct DuplicateReport {
+    // NOTE: the groups are sorted by the size of files (the largest first), the paths of every group are sorted
+    std::vector<DuplicateGroup> groups;
+    // NOTE: the quantities of files which have passed the stages of the search
+    size_t files{};
+    size_t size_candidates{};
+    size_t sample_candidates{};
+    // NOTE: the bytes which are read for hashing, so the I/O of the search is proportional to the quantity of likely duplicates
+    uint64_t read_bytes{};
+};
+
+// brief: finds the files with identical content by stages, every stage reads only the files which are left by the previous one:
+// | 1) the walk collects the sizes and the identities (device and inode) of regular files, the files of unique sizes are dropped;
+// | 2) the hash of the head and of the tail of every candidate is computed, the files of unique (size, hash) are dropped;
+// | 3) the hash of the whole content is computed only for the remaining candidates.
+// t-param: Base - target type to parallelization of walkers and of the stages of hashing
+// t-param: Engine - the way to read entries of OS catalogs (Linux enumeration engines only, see RecursiveWalking::WalkInBatches)
+// note: the files are considered identical by equal size and equal XXH64 of the whole content (see XxHash64-class)
+template<PARALLELIZATION_BASE Base = PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE Engine = ENUMERATION_ENGINE::LINUX_OPENAT>
+class DuplicateFinder {
+    struct Candidate {
+        fs::path path;
+        uint64_t size;
+        uint64_t device;
+        uint64_t inode;
+        uint64_t hash{};
+        // NOTE: the sample of the small file is its whole content, so the hash of the sample is final
+        bool is_hashed_fully{ false };
+        bool is_readable{ true };
+    };
+
+    size_t _threads_quantity;
+
+    // brief: calls the action(first, last) for every range of candidates with equal key, the candidates are sorted by the key before
+    template<class KeyType, class ActionType>
+    static void _ForEachGroup(std::vector<Candidate>& candidates, KeyType&& key, ActionType&& action) {
+        std::sort(candidates.begin(), candidates.end(), [&](const Candidate& left, const Candidate& right) { return key(left) < key(right); });
+        for (size_t first{ 0 }, last; first < candidates.size(); first = last) {
+            for (last = first + 1; last < candidates.size() && key(candidates[last]) == key(candidates[first]);)
+                ++last;
+            action(first, last);
+        }
+    }
+
+    // brief: keeps only the candidates which have the same key as at least one other candidate
+    template<class KeyType>
+    static void _DropUnique(std::vector<Candidate>& candidates, KeyType&& key) {
+        size_t kept{ 0 };
+        _ForEachGroup(candidates, key, [&](const size_t first, const size_t last) {
+            if (last - first > 1)
+                for (size_t i{ first }; i < last; ++i)
+                    candidates[kept++] = std::move(candidates[i]);
+        });
+        candidates.erase(candidates.begin() + kept, candidates.end());
+    }
+
+    static void _DropUnreadable(std::vector<Candidate>& candidates) {
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(), [](const Candidate& candidate) { return !candidate.is_readable; }), candidates.end());
+    }
+
+    // brief: hashes the head and the tail of the file (or the whole file if it is not larger than both of them)
+    // return: quantity of read bytes
+    static uint64_t _HashSample(Candidate& candidate) {
+        char sample[SAMPLE_SIZE * 2];
+        const int fd = ::open(candidate.path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+        if (fd < 0) {
+            candidate.is_readable = false;
+            return 0;
+        }
+
+        candidate.is_hashed_fully = candidate.size <= sizeof(sample);
+        const size_t head_size = static_cast<size_t>(std::min<uint64_t>(candidate.size, candidate.is_hashed_fully ? sizeof(sample) : SAMPLE_SIZE));
+        ssize_t read_size = ::pread(fd, sample, head_size, 0);
+        if (read_size == static_cast<ssize_t>(head_size) && !candidate.is_hashed_fully)
+            read_size += ::pread(fd, sample + SAMPLE_SIZE, SAMPLE_SIZE, static_cast<off_t>(candidate.size - SAMPLE_SIZE));
+        ::close(fd);
+
+        // NOTE: the file which is changed after the walk is not compared
+        const size_t sample_size{ candidate.is_hashed_fully ? head_size : sizeof(sample) };
+        if (read_size != static_cast<ssize_t>(sample_size)) {
+            candidate.is_readable = false;
+            return 0;
+        }
+        candidate.hash = XxHash64::Hash(sample, sample_size);
+        return sample_size;
+    }
+
+    static uint64_t _HashContent(Candidate& candidate) {
+        const std::optional<FileContent> content{ FileContent::Read(candidate.path) };
+        if (!content.has_value() || content->size() != candidate.size) {
+            candidate.is_readable = false;
+            return 0;
+        }
+        candidate.hash = XxHash64::Hash(content->View());
+        candidate.is_hashed_fully = true;
+        return content->size();
+    }
+
+    // brief: computes the hash of every candidate in parallel threads
+    template<class HashType>
+    void _HashCandidates(std::vector<Candidate>& candidates, HashType&& hash, DuplicateReport& report) const {
+        std::atomic<uint64_t> read_bytes{};
+        // NOTE: the hashing of one file is long (it waits for the disk), so the files are distributed one by one
+        ParallelExecutor<Base>{ _threads_quantity }.ParallelFor(candidates, 1, [&](Candidate& candidate) {
+            if (const uint64_t file_read_bytes = hash(candidate))
+                read_bytes.fetch_add(file_read_bytes, std::memory_order_relaxed);
+        });
+        report.read_bytes += read_bytes;
+    }
+
+    public:
+    // NOTE: the size of the head and of the tail of the file which are hashed on the second stage
+    static constexpr size_t SAMPLE_SIZE{ 4096 };
+
+    DuplicateFinder(const size_t threads_quantity = std::max<size_t>(2, std::thread::hardware_concurrency()))
+        : _threads_quantity{ threads_quantity } {
+        if (!_threads_quantity)
+            throw std::exception("quantity of parallel threads must be greater then zero");
+    }
+
+    // brief: finds the groups of files with identical content in the catalog and in all its sub catalogs
+    // param: min_size - the files which are smaller are not compared (by default the empty files are skipped)
+    DuplicateReport Find(const fs::path& catalog, const uint64_t min_size = 1) const {
+        DuplicateReport report{};
+        std::vector<Candidate> candidates{};
+        std::mutex candidates_mutex{};
+
+        RecursiveWalking<WALK_TYPE::WIDTH, Base, Engine>(SIZE_MAX, _threads_quantity)
+            .template WalkInBatches<true>(catalog, [&](size_t, const fs::path& dir_path, const EntriesView& entries) {
+                std::vector<Candidate> found{};
+                for (const EntryInfo& entry : entries)
+                    if (S_ISREG(entry.mode) && entry.size >= min_size)
+                        found.push_back(Candidate{ fs::path(dir_path) / entry.name, entry.size, entry.device, entry.inode });
+                std::lock_guard locker(candidates_mutex);
+                std::move(found.begin(), found.end(), std::back_inserter(candidates));
+            });
+
+        // NOTE: the hard links of one file are found by the pair of device and inode, the first path of the file is kept
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& left, const Candidate& right) {
+            return std::tie(left.device, left.inode, left.path) < std::tie(right.device, right.inode, right.path);
+        });
+        candidates.erase(
+            std::unique(
+                candidates.begin(),
+                candidates.end(),
+                [](const Candidate& left, const Candidate& right) { return left.device == right.device && left.inode == right.inode; }),
+            candidates.end());
+        report.files = candidates.size();
+
+        _DropUnique(candidates, [](const Candidate& candidate) { return candidate.size; });
+        report.size_candidates = candidates.size();
+
+        _HashCandidates(candidates, &DuplicateFinder::_HashSample, report);
+        _DropUnreadable(candidates);
+        _DropUnique(candidates, [](const Candidate& candidate) { return std::make_tuple(candidate.size, candidate.hash); });
+        report.sample_candidates = candidates.size();
+
+        _HashCandidates(candidates, [](Candidate& candidate) { return candidate.is_hashed_fully ? uint64_t{ 0 } : _HashContent(candidate); }, report);
+        _DropUnreadable(candidates);
+        _ForEachGroup(
+            candidates,
+            [](const Candidate& candidate) { return std::make_tuple(candidate.size, candidate.hash); },
+            [&](const size_t first, const size_t last) {
+                if (last - first < 2)
+                    return;
+                DuplicateGroup& group = report.groups.emplace_back(DuplicateGroup{ candidates[first].size, {} });
+                for (size_t i{ first }; i < last; ++i)
+                    group.paths.push_back(std::move(candidates[i].path));
+                std::sort(group.paths.begin(), group.paths.end());
+            });
+        std::sort(report.groups.begin(), report.groups.end(), [](const DuplicateGroup& left, const DuplicateGroup& right) {
+            return left.size != right.size ? left.size > right.size : left.paths.front() < right.paths.front();
+        });
+        return report;
+    }
+};
+#endif
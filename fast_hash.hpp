@@ -0,0 +1,80 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#include <cstring>
+
+// brief: XXH64 - the fast non-cryptographic hash of the content of files (see DuplicateFinder-class)
+// note: the input is processed by 32 bytes in four independent lanes, so the rounds of lanes do not wait for each other
+// | and the compiler keeps all lanes in registers; the result is the same as of the reference implementation of XXH64
+// note: the numbers are read in little-endian order, as the reference implementation does on little-endian processors
+class XxHash64 {
+    static constexpr uint64_t PRIME_1{ 0x9E3779B185EBCA87ULL };
+    static constexpr uint64_t PRIME_2{ 0xC2B2AE3D27D4EB4FULL };
+    static constexpr uint64_t PRIME_3{ 0x165667B19E3779F9ULL };
+    static constexpr uint64_t PRIME_4{ 0x85EBCA77C2B2AE63ULL };
+    static constexpr uint64_t PRIME_5{ 0x27D4EB2F165667C5ULL };
+
+    static constexpr uint64_t _RotateLeft(const uint64_t value, const int bits) noexcept {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    template<class ValueType>
+    static ValueType _Read(const unsigned char* const data) noexcept {
+        ValueType value;
+        std::memcpy(&value, data, sizeof(ValueType));
+        return value;
+    }
+
+    static constexpr uint64_t _Round(uint64_t accumulator, const uint64_t input) noexcept {
+        accumulator += input * PRIME_2;
+        return _RotateLeft(accumulator, 31) * PRIME_1;
+    }
+
+    static constexpr uint64_t _MergeRound(uint64_t accumulator, const uint64_t lane) noexcept {
+        accumulator ^= _Round(0, lane);
+        return accumulator * PRIME_1 + PRIME_4;
+    }
+
+    public:
+    static uint64_t Hash(const void* const data, const size_t size, const uint64_t seed = 0) noexcept {
+        const unsigned char* input = static_cast<const unsigned char*>(data);
+        const unsigned char* const end = input + size;
+        uint64_t result;
+
+        if (size >= 32) {
+            uint64_t lanes[4]{ seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1 };
+            for (const unsigned char* const last_stripe = end - 32; input <= last_stripe; input += 32)
+                for (size_t lane{ 0 }; lane < 4; ++lane)
+                    lanes[lane] = _Round(lanes[lane], _Read<uint64_t>(input + lane * 8));
+
+            result = _RotateLeft(lanes[0], 1) + _RotateLeft(lanes[1], 7) + _RotateLeft(lanes[2], 12) + _RotateLeft(lanes[3], 18);
+            for (const uint64_t lane : lanes)
+                result = _MergeRound(result, lane);
+        } else {
+            result = seed + PRIME_5;
+        }
+        result += static_cast<uint64_t>(size);
+
+        // NOTE: the tail which is shorter than the stripe is mixed by 8, 4 and 1 bytes
+        for (; end - input >= 8; input += 8)
+            result = _RotateLeft(result ^ _Round(0, _Read<uint64_t>(input)), 27) * PRIME_1 + PRIME_4;
+        if (end - input >= 4) {
+            result = _RotateLeft(result ^ (static_cast<uint64_t>(_Read<uint32_t>(input)) * PRIME_1), 23) * PRIME_2 + PRIME_3;
+            input += 4;
+        }
+        for (; input < end; ++input)
+            result = _RotateLeft(result ^ (*input * PRIME_5), 11) * PRIME_1;
+
+        result ^= result >> 33;
+        result *= PRIME_2;
+        result ^= result >> 29;
+        result *= PRIME_3;
+        result ^= result >> 32;
+        return result;
+    }
+
+    static uint64_t Hash(const std::string_view data, const uint64_t seed = 0) noexcept {
+        return Hash(data.data(), data.size(), seed);
+    }
+};
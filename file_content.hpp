@@ -0,0 +1,150 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// brief: the way to read the content of files by the readers of the pipeline (see RecursiveWalking::WalkInContent)
+// note: MMAP - the file is mapped and its pages are read by the reader at once (MAP_POPULATE), so the processor does not wait for the disk;
+// | PREAD - the file is read into own buffer by large pread-calls; AUTO - MMAP for large files and PREAD for small ones,
+// | because the mapping and the unmapping of a small file cost more than its copying
+// note: on other platforms the files are always read into the buffer
+enum class CONTENT_READING : uint8_t { AUTO, MMAP, PREAD };
+
+// brief: the settings of the stages of the content pipeline (see RecursiveWalking::WalkInContent)
+// note: the walkers of the pipeline are the threads of RecursiveWalking-class
+struct ContentPipelineOptions {
+    size_t readers_quantity{ 4 };
+    size_t processors_quantity{ std::max<size_t>(1, std::thread::hardware_concurrency()) };
+    // NOTE: the capacity of the queue of found files between the walkers and the readers
+    size_t paths_capacity{ 4096 };
+    // NOTE: the capacity of the queue of read files between the readers and the processors, it limits the memory of files which wait for processing
+    size_t contents_capacity{ 64 };
+    CONTENT_READING reading{ CONTENT_READING::AUTO };
+};
+
+// brief: the content of the file which is owned by the mapping or by the buffer, the processors get the view of it without copying
+class FileContent {
+    size_t _size{};
+    std::unique_ptr<char[]> _buffer{};
+#ifdef __linux__
+    void* _mapping{ MAP_FAILED };
+#endif
+
+    public:
+    // NOTE: the files of this size and larger are mapped with CONTENT_READING::AUTO
+    static constexpr size_t MMAP_THRESHOLD{ 256 * 1024 };
+    // NOTE: the size of one pread-call, the large calls keep the read-ahead of the kernel busy
+    static constexpr size_t READ_CHUNK_SIZE{ 1024 * 1024 };
+
+#pragma region constructors / destructor
+    FileContent() = default;
+
+    FileContent(FileContent&& other) noexcept
+        : _size{ std::exchange(other._size, 0) }
+        , _buffer{ std::move(other._buffer) }
+#ifdef __linux__
+        , _mapping{ std::exchange(other._mapping, MAP_FAILED) }
+#endif
+    {
+    }
+
+    FileContent& operator=(FileContent&& other) noexcept {
+        std::swap(_size, other._size);
+        std::swap(_buffer, other._buffer);
+#ifdef __linux__
+        std::swap(_mapping, other._mapping);
+#endif
+        return *this;
+    }
+
+    FileContent(const FileContent&) = delete;
+    FileContent& operator=(const FileContent&) = delete;
+
+    ~FileContent() {
+#ifdef __linux__
+        if (_mapping != MAP_FAILED)
+            ::munmap(_mapping, _size);
+#endif
+    }
+#pragma endregion constructors / destructor
+
+    // brief: reads the whole regular file
+    // return: the content or std::nullopt if the file can not be opened or it is not a regular file (FIFO, device, socket)
+    static std::optional<FileContent> Read(const fs::path& file, const CONTENT_READING reading = CONTENT_READING::AUTO) {
+        FileContent result{};
+#ifdef __linux__
+        // NOTE: O_NONBLOCK does not change the reading of regular files, but the opening of FIFO does not wait for its writer
+        const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+        if (fd < 0)
+            return std::nullopt;
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        const size_t file_size = static_cast<size_t>(file_stat.st_size);
+        if (file_size == 0) {
+            ::close(fd);
+            return result;
+        }
+
+        // NOTE: the whole file is read, so the kernel can double the read-ahead window
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        if (reading == CONTENT_READING::MMAP || (reading == CONTENT_READING::AUTO && file_size >= MMAP_THRESHOLD)) {
+            result._mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            if (result._mapping != MAP_FAILED) {
+                result._size = file_size;
+                ::close(fd);
+                return result;
+            }
+        }
+
+        result._buffer.reset(new char[file_size]);
+        while (result._size < file_size) {
+            const ssize_t read_size = ::pread(fd, result._buffer.get() + result._size, std::min(READ_CHUNK_SIZE, file_size - result._size), result._size);
+            // NOTE: the file may be truncated during the reading, then only the read part is given
+            if (read_size <= 0)
+                break;
+            result._size += static_cast<size_t>(read_size);
+        }
+        ::close(fd);
+#else
+        std::ifstream input(file, std::ios_base::binary | std::ios_base::ate);
+        if (!input)
+            return std::nullopt;
+        const size_t file_size = static_cast<size_t>(input.tellg());
+        input.seekg(0);
+        result._buffer.reset(new char[file_size]);
+        input.read(result._buffer.get(), file_size);
+        result._size = static_cast<size_t>(input.gcount());
+#endif
+        return result;
+    }
+
+    // note: the view is valid while the content is alive
+    std::string_view View() const noexcept {
+#ifdef __linux__
+        if (_mapping != MAP_FAILED)
+            return std::string_view(static_cast<const char*>(_mapping), _size);
+#endif
+        return std::string_view(_buffer.get(), _size);
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    bool IsMapped() const noexcept {
+#ifdef __linux__
+        return _mapping != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+};
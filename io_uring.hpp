@@ -0,0 +1,215 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+// brief: the ring of asynchronous operations of the kernel (io_uring) which is used by raw syscalls without liburing
+// note: the instance is not thread-safe and it is owned by one walker (see DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_IO_URING>)
+// note: io_uring may be unavailable (old kernel, kernel.io_uring_disabled, seccomp of the container), in this case the ring is not valid
+// | (see IsValid-method) and the owner must do the operations synchronously; the ring also stops being valid after the error of the submission
+// | (see Submit-method)
+class IoUring {
+    int _ring_fd{ -1 };
+    // NOTE: the error of io_uring_enter after which the ring takes no new operations
+    int _error{};
+    unsigned _entries{};
+    // NOTE: the tail of the submission queue with the prepared operations, it is published to the kernel by Submit-method
+    unsigned _prepared_tail{};
+    // NOTE: the operations which are prepared, but are not given to the kernel yet
+    unsigned _unsubmitted{};
+    // NOTE: the operations which are prepared, but their completions are not reaped yet; it never exceeds the quantity of entries,
+    // | so neither the submission queue nor the completion queue (which is twice larger) can overflow
+    unsigned _in_flight{};
+
+    void* _sq_ring{ MAP_FAILED };
+    size_t _sq_ring_size{};
+    void* _cq_ring{ MAP_FAILED };
+    size_t _cq_ring_size{};
+    io_uring_sqe* _sqes{ static_cast<io_uring_sqe*>(MAP_FAILED) };
+    size_t _sqes_size{};
+
+    unsigned* _sq_head{};
+    unsigned* _sq_tail{};
+    unsigned* _sq_mask{};
+    unsigned* _sq_array{};
+    unsigned* _cq_head{};
+    unsigned* _cq_tail{};
+    unsigned* _cq_mask{};
+    io_uring_cqe* _cqes{};
+
+    template<class PointerType>
+    static PointerType* _At(void* const ring, const unsigned offset) noexcept {
+        return reinterpret_cast<PointerType*>(static_cast<char*>(ring) + offset);
+    }
+
+    bool _Map(const io_uring_params& params) noexcept {
+        _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        // NOTE: the new kernels map both rings by one mapping
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+
+        _sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+        if (_sq_ring == MAP_FAILED)
+            return false;
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            _cq_ring = _sq_ring;
+        } else {
+            _cq_ring = ::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+            if (_cq_ring == MAP_FAILED)
+                return false;
+        }
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES));
+        if (_sqes == MAP_FAILED)
+            return false;
+
+        _sq_head = _At<unsigned>(_sq_ring, params.sq_off.head);
+        _sq_tail = _At<unsigned>(_sq_ring, params.sq_off.tail);
+        _sq_mask = _At<unsigned>(_sq_ring, params.sq_off.ring_mask);
+        _sq_array = _At<unsigned>(_sq_ring, params.sq_off.array);
+        _cq_head = _At<unsigned>(_cq_ring, params.cq_off.head);
+        _cq_tail = _At<unsigned>(_cq_ring, params.cq_off.tail);
+        _cq_mask = _At<unsigned>(_cq_ring, params.cq_off.ring_mask);
+        _cqes = _At<io_uring_cqe>(_cq_ring, params.cq_off.cqes);
+        _prepared_tail = *_sq_tail;
+        return true;
+    }
+
+    void _Unmap() noexcept {
+        if (_sqes != MAP_FAILED)
+            ::munmap(_sqes, _sqes_size);
+        if (_cq_ring != MAP_FAILED && _cq_ring != _sq_ring)
+            ::munmap(_cq_ring, _cq_ring_size);
+        if (_sq_ring != MAP_FAILED)
+            ::munmap(_sq_ring, _sq_ring_size);
+        if (_ring_fd >= 0)
+            ::close(_ring_fd);
+        _ring_fd = -1;
+    }
+
+    public:
+    // param: entries - the size of the submission queue, the kernel rounds it up to the power of two
+    explicit IoUring(const unsigned entries) noexcept {
+        io_uring_params params{};
+        _ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (_ring_fd < 0)
+            return;
+        if (!_Map(params)) {
+            _Unmap();
+            return;
+        }
+        _entries = params.sq_entries;
+    }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // NOTE: the owner must reap all operations before the destruction (see WaitAll-method), because the kernel may still write into their buffers
+    ~IoUring() {
+        _Unmap();
+    }
+
+    // NOTE: the time of the polling of the completions after the error of the submission (see WaitAll-method)
+    static constexpr std::chrono::milliseconds FAILED_WAIT_TIMEOUT{ 1000 };
+
+    bool IsValid() const noexcept {
+        return _ring_fd >= 0 && !_error;
+    }
+
+    unsigned GetInFlight() const noexcept {
+        return _in_flight;
+    }
+
+    // brief: takes the free entry of the submission queue, the operation is given to the kernel by Submit-method
+    // return: the zeroed entry or nullptr if the ring is full or is not valid
+    io_uring_sqe* PrepareSqe() noexcept {
+        if (!IsValid() || _in_flight == _entries)
+            return nullptr;
+
+        const unsigned index = _prepared_tail++ & *_sq_mask;
+        io_uring_sqe* const sqe = &_sqes[index];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        _sq_array[index] = index;
+        ++_unsubmitted;
+        ++_in_flight;
+        return sqe;
+    }
+
+    // brief: gives the prepared operations to the kernel by one syscall
+    // param: min_complete - the quantity of completions to wait for, 0 - the call does not wait
+    // return: 0 or the error of io_uring_enter (EBADF if the ring is not created); after the error the ring is not valid and the operations
+    // | which are not taken by the kernel are completed with -ECANCELED by Reap-method, so the owner does them synchronously
+    int Submit(const unsigned min_complete = 0) noexcept {
+        if (!IsValid())
+            return _error ? _error : EBADF;
+        if (!_unsubmitted && !min_complete)
+            return 0;
+
+        // NOTE: the release store publishes the filled entries to the kernel
+        __atomic_store_n(_sq_tail, _prepared_tail, __ATOMIC_RELEASE);
+        const unsigned flags{ min_complete ? IORING_ENTER_GETEVENTS : 0u };
+        long submitted;
+        while ((submitted = ::syscall(__NR_io_uring_enter, _ring_fd, _unsubmitted, min_complete, flags, nullptr, 0)) < 0 && errno == EINTR) {}
+        if (submitted < 0) {
+            _error = errno;
+            // NOTE: the kernel takes the entries only in io_uring_enter, so the entries which are not taken are withdrawn
+            __atomic_store_n(_sq_tail, _prepared_tail - _unsubmitted, __ATOMIC_RELEASE);
+            return _error;
+        }
+        // NOTE: the entries which are not taken by the kernel stay published and are taken by the next call
+        _unsubmitted -= std::min(_unsubmitted, static_cast<unsigned>(submitted));
+        return 0;
+    }
+
+    // brief: calls the action(user_data, result) for every completed operation without waiting
+    // return: quantity of reaped completions, the ring which is not valid has no completions
+    template<class ActionType>
+    unsigned Reap(ActionType&& action) {
+        if (_ring_fd < 0)
+            return 0;
+
+        unsigned reaped{};
+        // NOTE: the operations which are withdrawn after the error of the submission are completed as canceled
+        for (; _error && _unsubmitted; --_unsubmitted, ++reaped) {
+            --_in_flight;
+            action(_sqes[(_prepared_tail - _unsubmitted) & *_sq_mask].user_data, -ECANCELED);
+        }
+
+        unsigned head{ *_cq_head };
+        const unsigned tail{ __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE) };
+        reaped += tail - head;
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = _cqes[head & *_cq_mask];
+            --_in_flight;
+            action(cqe.user_data, cqe.res);
+        }
+        // NOTE: the release store returns the entries of the completion queue to the kernel after they are read
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        return reaped;
+    }
+
+    // brief: submits the prepared operations and waits for the completions of all operations in flight
+    // note: after the error of the submission the completions are polled without the syscall during FAILED_WAIT_TIMEOUT,
+    // | the operations which are not completed after it are abandoned (e.g. their completions are dropped by the kernel)
+    template<class ActionType>
+    void WaitAll(ActionType&& action) {
+        while (_in_flight && Submit(1) == 0)
+            Reap(action);
+        if (_ring_fd < 0)
+            return;
+
+        for (const auto deadline = std::chrono::steady_clock::now() + FAILED_WAIT_TIMEOUT; _in_flight && std::chrono::steady_clock::now() < deadline;)
+            if (!Reap(action))
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        _in_flight = 0;
+    }
+};
+#endif
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#include <sstream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <climits>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+// brief: the scheduling class of workers (see LaunchPolicy::scheduling)
+// note: NORMAL - the class of the launching thread is kept, BATCH - SCHED_BATCH (the CPU-bound work without preemption of interactive threads),
+// | IDLE - SCHED_IDLE (the workers run only when the CPU has nothing else to do, for background scans)
+enum class SCHEDULING_CLASS : uint8_t { NORMAL, BATCH, IDLE };
+
+// brief: the way to place workers on the CPUs of the policy (see LaunchPolicy::pinning)
+// note: SET - every worker may run on any CPU of the policy, SPREAD - the worker i is pinned to one CPU (i modulo quantity of CPUs)
+enum class PINNING : uint8_t { SET, SPREAD };
+
+// brief: the placement and the priority of the workers which are launched by ParallelExecutor-class (see ParallelExecutor::SetLaunchPolicy)
+// note: the policy is applied by every worker to itself at its start and is reverted at its finish (see ThreadScope-class),
+// | so the threads of the pool (see ThreadPool-class) are given back with their settings
+// note: the settings are supported only on Linux, on other platforms the policy is ignored
+struct LaunchPolicy {
+    // NOTE: the indices of CPUs, empty - the CPUs of the launching thread
+    std::vector<size_t> cpus{};
+    // NOTE: the CPUs of the NUMA nodes are added to cpus, and the memory of workers is allocated on these nodes (MPOL_BIND)
+    std::vector<size_t> numa_nodes{};
+    PINNING pinning{ PINNING::SET };
+    SCHEDULING_CLASS scheduling{ SCHEDULING_CLASS::NORMAL };
+    // NOTE: the nice value of workers (from -20 to 19), std::nullopt - the value of the launching thread
+    std::optional<int> nice{};
+
+    bool IsDefault() const noexcept {
+        return cpus.empty() && numa_nodes.empty() && scheduling == SCHEDULING_CLASS::NORMAL && !nice.has_value();
+    }
+
+    // brief: reads the CPUs of the NUMA node from /sys/devices/system/node/node<index>/cpulist ("0-3,8-11")
+    static std::vector<size_t> GetNodeCpus(const size_t node) {
+        std::ifstream cpu_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string ranges{};
+        if (!std::getline(cpu_list, ranges))
+            throw std::exception("NUMA node is not found");
+
+        std::vector<size_t> result{};
+        std::stringstream ranges_stream{ ranges };
+        for (std::string range{}; std::getline(ranges_stream, range, ',');) {
+            if (range.empty())
+                continue;
+            const size_t dash = range.find('-');
+            const size_t first = std::stoul(range.substr(0, dash));
+            const size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (size_t cpu{ first }; cpu <= last; ++cpu)
+                result.push_back(cpu);
+        }
+        return result;
+    }
+
+    // brief: the copy of the policy where the CPUs of numa_nodes are added to cpus, the CPUs are sorted and unique
+    // note: it is called once by the launching thread, so the workers do not read sysfs and the errors are thrown to the caller
+    LaunchPolicy Resolve() const {
+        LaunchPolicy result{ *this };
+        for (const size_t node : numa_nodes) {
+            const std::vector<size_t> node_cpus{ GetNodeCpus(node) };
+            result.cpus.insert(result.cpus.end(), node_cpus.begin(), node_cpus.end());
+        }
+        std::sort(result.cpus.begin(), result.cpus.end());
+        result.cpus.erase(std::unique(result.cpus.begin(), result.cpus.end()), result.cpus.end());
+#ifdef __linux__
+        if (!result.cpus.empty() && result.cpus.back() >= CPU_SETSIZE)
+            throw std::exception("index of CPU is out of CPU_SETSIZE");
+        for (const size_t node : numa_nodes)
+            if (node >= sizeof(unsigned long) * CHAR_BIT)
+                throw std::exception("index of NUMA node is out of the mask of nodes");
+#endif
+        if (nice.has_value() && (nice.value() < -20 || nice.value() > 19))
+            throw std::exception("nice value must be from -20 to 19");
+        return result;
+    }
+
+    // brief: applies the resolved policy (see Resolve-method) to the calling thread and reverts it at the destruction
+    // note: the settings which are refused by OS are skipped, for example the CPUs outside of the cpuset of the process;
+    // | without CAP_SYS_NICE the lowered priority (nice, SCHED_IDLE) can not be raised back, so the thread of the pool keeps it,
+    // | give own pool to the executor of background work then (see ParallelExecutor-class)
+    // note: the thread which is created by the worker inherits the settings of the worker
+    class ThreadScope {
+#ifdef __linux__
+        std::optional<cpu_set_t> _previous_cpus{};
+        std::optional<int> _previous_memory_mode{};
+        unsigned long _previous_nodes{};
+        std::optional<int> _previous_scheduling{};
+        sched_param _previous_scheduling_param{};
+        std::optional<int> _previous_nice{};
+#endif
+
+        public:
+        // param: worker_index - the index of the worker among the workers of one launch, it selects the CPU with PINNING::SPREAD
+        ThreadScope(const LaunchPolicy& policy, const size_t worker_index) {
+#ifdef __linux__
+            if (!policy.cpus.empty()) {
+                cpu_set_t previous, target;
+                CPU_ZERO(&target);
+                if (policy.pinning == PINNING::SPREAD)
+                    CPU_SET(policy.cpus[worker_index % policy.cpus.size()], &target);
+                else
+                    for (const size_t cpu : policy.cpus)
+                        CPU_SET(cpu, &target);
+                if (::sched_getaffinity(0, sizeof(previous), &previous) == 0 && ::sched_setaffinity(0, sizeof(target), &target) == 0)
+                    _previous_cpus = previous;
+            }
+            if (!policy.numa_nodes.empty()) {
+                unsigned long nodes{};
+                for (const size_t node : policy.numa_nodes)
+                    nodes |= 1UL << node;
+                int previous_mode{};
+                if (::syscall(SYS_get_mempolicy, &previous_mode, &_previous_nodes, sizeof(_previous_nodes) * CHAR_BIT, nullptr, 0) == 0
+                    && ::syscall(SYS_set_mempolicy, MPOL_BIND, &nodes, sizeof(nodes) * CHAR_BIT) == 0)
+                    _previous_memory_mode = previous_mode;
+            }
+            if (policy.scheduling != SCHEDULING_CLASS::NORMAL) {
+                const int previous = ::sched_getscheduler(0);
+                const sched_param target{ 0 };
+                if (previous >= 0 && ::sched_getparam(0, &_previous_scheduling_param) == 0
+                    && ::sched_setscheduler(0, policy.scheduling == SCHEDULING_CLASS::IDLE ? SCHED_IDLE : SCHED_BATCH, &target) == 0)
+                    _previous_scheduling = previous;
+            }
+            // NOTE: the nice value of Linux belongs to the thread, so it is set by the identifier of the thread
+            if (policy.nice.has_value()) {
+                const id_t tid = static_cast<id_t>(::syscall(SYS_gettid));
+                errno = 0;
+                const int previous = ::getpriority(PRIO_PROCESS, tid);
+                if (errno == 0 && ::setpriority(PRIO_PROCESS, tid, policy.nice.value()) == 0)
+                    _previous_nice = previous;
+            }
+#endif
+        }
+
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+
+        ~ThreadScope() {
+#ifdef __linux__
+            if (_previous_nice.has_value())
+                ::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), _previous_nice.value());
+            if (_previous_scheduling.has_value())
+                ::sched_setscheduler(0, _previous_scheduling.value(), &_previous_scheduling_param);
+            if (_previous_memory_mode.has_value())
+                ::syscall(SYS_set_mempolicy, _previous_memory_mode.value(), &_previous_nodes, sizeof(_previous_nodes) * CHAR_BIT);
+            if (_previous_cpus.has_value())
+                ::sched_setaffinity(0, sizeof(cpu_set_t), &_previous_cpus.value());
+#endif
+        }
+    };
+};
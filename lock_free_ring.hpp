@@ -0,0 +1,129 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: lock-free bounded multi-producer multi-consumer queue (the ring of slots with sequence numbers)
+// t-param: ElementType - data-type of the element of the ring, it must be nothrow move constructible
+// note: every slot has own sequence number which tells producers and consumers whether the slot is free or filled for the current lap of the ring,
+// | so the producers and the consumers compete only on own position counter and never take any lock.
+// note: the slots and the position counters are placed in separate cache lines, so that neighbour operations do not invalidate each other.
+template<class ElementType>
+class LockFreeRing {
+    static_assert(std::is_nothrow_move_constructible_v<ElementType>, "element of lock-free ring must be nothrow move constructible");
+
+#pragma region inner types and aliases
+    using OptElementType = std::optional<ElementType>;
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic_size_t sequence{};
+        alignas(ElementType) unsigned char storage[sizeof(ElementType)];
+
+        ElementType* element() noexcept {
+            return std::launder(reinterpret_cast<ElementType*>(storage));
+        }
+    };
+#pragma endregion inner types and aliases
+
+    size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t _enqueue_position{};
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t _dequeue_position{};
+
+    // NOTE: the ring of one slot can not distinguish the filled slot from the free slot of the next lap, so two slots is the minimum
+    static size_t _RoundUpToPowerOfTwo(const size_t value) noexcept {
+        size_t result{ 2 };
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    public:
+#pragma region constructors / destructor
+    // note: capacity - is rounded up to the power of two (but not less then two)
+    LockFreeRing(const size_t capacity)
+        : _mask{ _RoundUpToPowerOfTwo(capacity) - 1 }
+        , _slots{ std::make_unique<Slot[]>(_mask + 1) } {
+        if (!capacity)
+            throw std::exception("capacity of ring must be greater then zero");
+        for (size_t i{ 0 }; i <= _mask; ++i)
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreeRing(const LockFreeRing&) = delete;
+    LockFreeRing& operator=(const LockFreeRing&) = delete;
+
+    ~LockFreeRing() {
+        while (ExtractFront().has_value())
+            ;
+    }
+#pragma endregion constructors / destructor
+
+    // brief: adds the element to the end of the ring
+    // return: false if the ring is full and the element is not added
+    template<class... ArgsTypes>
+    bool emplace_back(ArgsTypes&&... args) {
+        // NOTE: the element is created before taking of the slot, so an exception of its constructor does not break the ring
+        return push_back(ElementType(std::forward<ArgsTypes>(args)...));
+    }
+
+    // brief: moves the element to the end of the ring
+    // return: false if the ring is full, in this case the element stays untouched
+    bool push_back(ElementType&& element) noexcept {
+        size_t position = _enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = _slots[position & _mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+            if (difference == 0) {
+                if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    new (slot.storage) ElementType(std::move(element));
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = _enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // brief: extracts the element from the front of the ring
+    // return: the element or std::nullopt if the ring is empty
+    OptElementType ExtractFront() noexcept {
+        OptElementType result;
+        size_t position = _dequeue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = _slots[position & _mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position + 1);
+            if (difference == 0) {
+                if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    result.emplace(std::move(*slot.element()));
+                    slot.element()->~ElementType();
+                    slot.sequence.store(position + _mask + 1, std::memory_order_release);
+                    return result;
+                }
+            } else if (difference < 0) {
+                return result;
+            } else {
+                position = _dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // note: the size is approximate while producers or consumers are working with the ring
+    size_t size() const noexcept {
+        const size_t dequeue_position = _dequeue_position.load(std::memory_order_relaxed);
+        const size_t enqueue_position = _enqueue_position.load(std::memory_order_relaxed);
+        return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_t capacity() const noexcept {
+        return _mask + 1;
+    }
+};
@@ -2,15 +2,75 @@
 
 #include "parallelization_unit.hpp"
 
+// brief: the way to distribute the chunks of a range between threads (see ParallelExecutor::ParallelFor)
+// note: STATIC - the chunks are given to threads in turn before the start, DYNAMIC - every thread takes the next free chunk when it finished previous one
+enum class CHUNKING : uint8_t { STATIC, DYNAMIC };
+
 template<PARALLELIZATION_BASE Base>
 class ParallelExecutor {
     size_t _parallel_threads_quantity;
+    std::shared_ptr<ThreadPool> _thread_pool;
+    // NOTE: the resolved policy (see LaunchPolicy::Resolve), std::nullopt - the threads are launched without changes
+    std::optional<LaunchPolicy> _launch_policy{};
+
+    // brief: the partial result of one thread of ParallelReduce-method, the results of threads are separated by cache lines
+    template<class ResultType>
+    struct alignas(CACHE_LINE_SIZE) PartialResult {
+        ResultType value;
+    };
+
+    // brief: launches threads and calls the action for every chunk [first, last) of indices [0, size) which is given to the thread
+    // note: grain - the size of chunk, 0 - the size is chosen by the quantity of threads
+    template<CHUNKING Chunking, class ChunkActionType>
+    void _ForEachChunk(const size_t size, size_t grain, ChunkActionType&& chunk_action) {
+        if (!size)
+            return;
+        if (!grain)
+            // NOTE: the dynamic chunking needs more chunks than threads to balance the load
+            grain = std::max<size_t>(1, size / (_parallel_threads_quantity * (Chunking == CHUNKING::DYNAMIC ? 8 : 1)));
+
+        const size_t chunks_quantity = (size + grain - 1) / grain;
+        std::atomic_size_t next_thread{}, next_chunk{};
+        auto worker = [&]() {
+            const size_t thread_index = next_thread++;
+            auto process = [&](const size_t chunk) { chunk_action(thread_index, chunk * grain, std::min(size, (chunk + 1) * grain)); };
+            if constexpr (Chunking == CHUNKING::STATIC) {
+                for (size_t chunk{ thread_index }; chunk < chunks_quantity; chunk += _parallel_threads_quantity)
+                    process(chunk);
+            } else {
+                for (size_t chunk{ next_chunk++ }; chunk < chunks_quantity; chunk = next_chunk++)
+                    process(chunk);
+            }
+        };
+        Launch(worker).WaitWhileAllFinished();
+    }
 
     public:
-    ParallelExecutor(const size_t parallel_threads_quantity = std::thread::hardware_concurrency())
-        : _parallel_threads_quantity{ parallel_threads_quantity } {
+    // note: thread_pool - the pool of threads for PARALLELIZATION_BASE::THREAD_POOL, if it is not set the shared pool is used (see ThreadPool::Shared)
+    ParallelExecutor(const size_t parallel_threads_quantity = std::thread::hardware_concurrency(), std::shared_ptr<ThreadPool> thread_pool = nullptr)
+        : _parallel_threads_quantity{ parallel_threads_quantity }
+        , _thread_pool{ std::move(thread_pool) } {
         if (_parallel_threads_quantity == 0)
             throw std::exception("quantity of active threads must be greater then zero");
+        if constexpr (Base == PARALLELIZATION_BASE::THREAD_POOL)
+            if (!_thread_pool)
+                _thread_pool = ThreadPool::Shared();
+    }
+
+    // brief: sets the placement and the priority of the threads which are launched by Launch-method, ParallelFor-method and ParallelReduce-method
+    // note: the CPUs of NUMA nodes are read here, so the wrong policy is reported to the caller, not to the threads
+    ParallelExecutor& SetLaunchPolicy(const LaunchPolicy& policy) {
+        return SetResolvedLaunchPolicy(policy.IsDefault() ? policy : policy.Resolve());
+    }
+
+    // brief: the same as SetLaunchPolicy-method for the policy which is already resolved by the caller (see LaunchPolicy::Resolve),
+    // | so sysfs is not read again and nothing is thrown for every launch (see RecursiveWalking::SetLaunchPolicy)
+    ParallelExecutor& SetResolvedLaunchPolicy(const LaunchPolicy& resolved_policy) {
+        if (resolved_policy.IsDefault())
+            _launch_policy.reset();
+        else
+            _launch_policy = resolved_policy;
+        return *this;
     }
 
     // brief: parallelization unit created of an instance of ParallelExecutor-class
@@ -23,10 +83,55 @@ class ParallelExecutor {
     template<bool IsSafeMode = true, class FunctionType, class... ArgsTypes>
     decltype(auto) Launch(FunctionType&& function, ArgsTypes&&... args) {
         auto action = std::bind(function, std::forward<ArgsTypes>(args)...);
-        return ParallelizationUnit<IsSafeMode, Base, decltype(action)>(_parallel_threads_quantity, std::move(action));
+        return ParallelizationUnit<IsSafeMode, Base, decltype(action)>(
+            _parallel_threads_quantity, std::move(action), _thread_pool.get(), _launch_policy.has_value() ? &_launch_policy.value() : nullptr);
+    }
+
+    // brief: calls the function for every element of the range in parallel threads and waits while all of them are finished
+    // t-param: Chunking - the way to distribute the chunks of the range between threads (see CHUNKING)
+    // param: range - the range with random access iterators (for example std::vector), the function gets the reference to the element
+    // param: grain - the quantity of elements in one chunk, 0 - the quantity is chosen by the quantity of threads
+    template<CHUNKING Chunking = CHUNKING::DYNAMIC, class RangeType, class FunctionType>
+    void ParallelFor(RangeType&& range, const size_t grain, FunctionType&& function) {
+        auto first = std::begin(range);
+        static_assert(
+            std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<decltype(first)>::iterator_category>,
+            "ParallelFor-method needs the range with random access iterators");
+
+        _ForEachChunk<Chunking>(static_cast<size_t>(std::distance(first, std::end(range))), grain, [&](size_t, const size_t chunk_first, const size_t chunk_last) {
+            for (auto it = first + chunk_first, chunk_end = first + chunk_last; it != chunk_end; ++it)
+                function(*it);
+        });
+    }
+
+    // brief: reduces the range in parallel threads: every thread accumulates own partial result, then the partial results are combined
+    // param: identity - the initial value of every partial result (the neutral value of the combination)
+    // param: function - ResultType(ResultType&& accumulated, element), adds the element to the partial result of the thread
+    // param: combine - ResultType(ResultType&& left, ResultType&& right), combines two partial results, it must be associative and commutative
+    // return: the combination of all partial results (identity for the empty range)
+    template<CHUNKING Chunking = CHUNKING::DYNAMIC, class RangeType, class ResultType, class FunctionType, class CombineType>
+    ResultType ParallelReduce(RangeType&& range, const size_t grain, const ResultType& identity, FunctionType&& function, CombineType&& combine) {
+        auto first = std::begin(range);
+        static_assert(
+            std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<decltype(first)>::iterator_category>,
+            "ParallelReduce-method needs the range with random access iterators");
+
+        std::vector<PartialResult<ResultType>> partial_results(_parallel_threads_quantity, PartialResult<ResultType>{ identity });
+        _ForEachChunk<Chunking>(
+            static_cast<size_t>(std::distance(first, std::end(range))), grain, [&](const size_t thread_index, const size_t chunk_first, const size_t chunk_last) {
+                ResultType& partial_result = partial_results[thread_index].value;
+                for (auto it = first + chunk_first, chunk_end = first + chunk_last; it != chunk_end; ++it)
+                    partial_result = function(std::move(partial_result), *it);
+            });
+
+        ResultType result{ std::move(partial_results.front().value) };
+        for (size_t i{ 1 }; i < partial_results.size(); ++i)
+            result = combine(std::move(result), std::move(partial_results[i].value));
+        return result;
     }
 };
 
 using ParallelExecutorTHD = ParallelExecutor<PARALLELIZATION_BASE::STD_THREAD>;
 using ParallelExecutorFUT = ParallelExecutor<PARALLELIZATION_BASE::STD_FUTURE>;
 using ParallelExecutorSLT = ParallelExecutor<PARALLELIZATION_BASE::STL_ALGORITHMS>;
+using ParallelExecutorTPL = ParallelExecutor<PARALLELIZATION_BASE::THREAD_POOL>;
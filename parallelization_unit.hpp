@@ -1,9 +1,11 @@
 #pragma once
 
-#include "thread_safe_container.hpp"
+#include "stdafx.hpp"
 #include "thread_status.hpp"
+#include "thread_pool.hpp"
+#include "launch_policy.hpp"
 
-enum class PARALLELIZATION_BASE : uint8_t { STD_THREAD, STD_FUTURE, STL_ALGORITHMS };
+enum class PARALLELIZATION_BASE : uint8_t { STD_THREAD, STD_FUTURE, STL_ALGORITHMS, THREAD_POOL };
 
 template<PARALLELIZATION_BASE Base>
 class ParallelExecutor;
@@ -21,57 +23,78 @@ class ParallelizationUnit {
 
     using ActionReturnType = std::invoke_result_t<ActionType>;
     using ThreadStatusType = ThreadStatus<ActionReturnType>;
-    using ThreadStatusTypeShrPtr = std::shared_ptr<ThreadStatusType>;
 
     size_t _threads_quantity{};
     ActionType _parallelized_action;
-    std::atomic<uint8_t> _active_threads_counter{};
-    ThreadSafeVector<ThreadStatusTypeShrPtr> _threads{};
+    // NOTE: the counters are changed only under the mutex, so that the waiting threads can be parked on the condition variable
+    size_t _launched_threads_counter{};
+    size_t _unfinished_threads_counter{};
+    mutable std::mutex _status_mutex{};
+    mutable std::condition_variable _status_changed{};
+    // NOTE: the table of statuses is allocated once for all threads, every thread writes only own status (one cache line) without locking
+    std::unique_ptr<ThreadStatusType[]> _threads;
 
     template<class ActionType>
     void _RunThreadsByStdThread(ActionType&& action) {
-        for (size_t i{ 0 }; i < _threads_quantity; ++i) {
-            ThreadStatusTypeShrPtr tsPtr = _threads.emplace_back(std::make_shared<ThreadStatusType>());
-            std::thread(action, std::move(tsPtr)).detach();
-        }
+        for (size_t i{ 0 }; i < _threads_quantity; ++i)
+            std::thread(action, std::ref(_threads[i])).detach();
     }
 
     template<class ActionType>
     void _RunThreadsByStdAsync(ActionType&& action) {
-        for (size_t i{ 0 }; i < _threads_quantity; ++i) {
-            ThreadStatusTypeShrPtr tsPtr = _threads.emplace_back(std::make_shared<ThreadStatusType>());
-            std::async(std::launch::async, action, std::move(tsPtr));
-        }
+        for (size_t i{ 0 }; i < _threads_quantity; ++i)
+            std::async(std::launch::async, action, std::ref(_threads[i]));
     }
 
     template<class ActionType>
     void _RunThreadsByStdAlgorithm(ActionType&& action) {
+        std::thread([&]() { std::for_each(std::execution::par, _threads.get(), _threads.get() + _threads_quantity, action); }).detach();
+    }
+
+    template<class ActionType>
+    void _RunThreadsByThreadPool(ActionType&& action, ThreadPool& thread_pool) {
         for (size_t i{ 0 }; i < _threads_quantity; ++i)
-            _threads.emplace_back(std::make_shared<ThreadStatusType>());
-        std::thread([&]() { std::for_each(std::execution::par, _threads.begin(), _threads.end(), action); }).detach();
+            thread_pool.Submit([action, ts_ptr = &_threads[i]]() { action(*ts_ptr); });
+    }
+
+    void _NotifyLaunched() {
+        std::lock_guard lock(_status_mutex);
+        if (++_launched_threads_counter == _threads_quantity)
+            _status_changed.notify_all();
+    }
+
+    void _NotifyFinished() {
+        std::lock_guard lock(_status_mutex);
+        if (--_unfinished_threads_counter == 0)
+            _status_changed.notify_all();
     }
 
     void _WaitWhileAllLaunched() {
-        for (auto it_b = _threads.begin(), it_e = _threads.end();
-             std::find_if_not(it_b, it_e, [](const ThreadStatusTypeShrPtr&st_ptr) { return st_ptr->th_id.has_value(); }) != it_e;
-             /* INFINITY */)
-            std::this_thread::yield();
+        std::unique_lock lock(_status_mutex);
+        _status_changed.wait(lock, [this]() { return _launched_threads_counter == _threads_quantity; });
     }
 
-    ParallelizationUnit(const size_t threads_quantity, ActionType&& action)
+    // note: thread_pool - the pool of threads which is used only with PARALLELIZATION_BASE::THREAD_POOL
+    // note: policy - the resolved launch policy of threads (see LaunchPolicy::Resolve), nullptr - the threads are not changed;
+    // | it is read by the threads only before their launch is notified, so it must live only during the construction
+    ParallelizationUnit(
+        const size_t threads_quantity, ActionType&& action, ThreadPool* const thread_pool = nullptr, const LaunchPolicy* const policy = nullptr)
         : _threads_quantity(threads_quantity)
-        , _parallelized_action{ std::move(action) } {
-        _threads.reserve(_threads_quantity);
-
-        auto target_action = [this](const ThreadStatusTypeShrPtr& ts_ptr) {
-            ++this->_active_threads_counter;
-            ts_ptr->th_id = std::this_thread::get_id();
+        , _parallelized_action{ std::move(action) }
+        , _unfinished_threads_counter{ threads_quantity }
+        , _threads{ std::make_unique<ThreadStatusType[]>(threads_quantity) } {
+        auto target_action = [this, policy](ThreadStatusType& status) {
+            status.th_id = std::this_thread::get_id();
+            std::optional<LaunchPolicy::ThreadScope> policy_scope{};
+            if (policy)
+                policy_scope.emplace(*policy, static_cast<size_t>(&status - this->_threads.get()));
+            this->_NotifyLaunched();
             if constexpr (!std::is_same_v<ActionReturnType, void>)
-                ts_ptr->result = this->_parallelized_action();
+                status.result.emplace(this->_parallelized_action());
             else
                 this->_parallelized_action();
-            ts_ptr->is_finished = true;
-            --this->_active_threads_counter;
+            status.is_finished.store(true, std::memory_order_release);
+            this->_NotifyFinished();
         };
 
         if constexpr (Base == PARALLELIZATION_BASE::STD_THREAD)
@@ -80,6 +103,8 @@ class ParallelizationUnit {
             _RunThreadsByStdAsync(std::move(target_action));
         else if constexpr (Base == PARALLELIZATION_BASE::STL_ALGORITHMS)
             _RunThreadsByStdAlgorithm(std::move(target_action));
+        else if constexpr (Base == PARALLELIZATION_BASE::THREAD_POOL)
+            _RunThreadsByThreadPool(std::move(target_action), *thread_pool);
         else
             static_assert(false, "target palatalization type is not implemented");
 
@@ -87,7 +112,8 @@ class ParallelizationUnit {
     }
 
     public:
-    ParallelizationUnit(ParallelizationUnit&&) noexcept = default;
+    // NOTE: the unit keeps the mutex and the condition variable which are waited by the launched threads, so it is not movable
+    ParallelizationUnit(ParallelizationUnit&&) = delete;
 
     ~ParallelizationUnit() {
         if constexpr (IsSafeMode)
@@ -95,23 +121,45 @@ class ParallelizationUnit {
     }
 
     size_t GetLaunchedThreads() const {
-        return _threads.size();
+        return _threads_quantity;
     }
 
     size_t GetActiveThreads() const {
         size_t result{};
-        for (const auto& ts_ptr : _threads)
-            if (!static_cast<bool>(ts_ptr->is_finished))
+        for (size_t i{ 0 }; i < _threads_quantity; ++i)
+            if (!_threads[i].is_finished.load(std::memory_order_acquire))
                 ++result;
         return result;
     }
 
-    template<uint8_t milliseconds = 0ui8>
+    // brief: waits while all launched threads are finished and takes out their results
+    // return: one result per thread, the results are moved out, so the next call returns only the results which are not taken yet
+    std::vector<ActionReturnType> ExtractResults() {
+        static_assert(!std::is_same_v<ActionReturnType, void>, "the action has no result");
+        WaitWhileAllFinished<0>();
+
+        std::vector<ActionReturnType> results{};
+        results.reserve(_threads_quantity);
+        for (size_t i{ 0 }; i < _threads_quantity; ++i)
+            if (std::optional<ActionReturnType>& result = _threads[i].result; result.has_value()) {
+                results.emplace_back(std::move(result.value()));
+                result.reset();
+            }
+        return results;
+    }
+
+    // brief: parks the calling thread until all launched threads are finished
+    // t-param: milliseconds - it is kept for the compatibility only: the waiting was the polling with this interval, now it is always blocking
+    template<size_t milliseconds = 0>
     void WaitWhileAllFinished() const {
-        while (static_cast<uint8_t>(_active_threads_counter) > 0ui8)
-            if constexpr (milliseconds == 0ui8)
-                std::this_thread::yield();
-            else
-                std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        std::unique_lock lock(_status_mutex);
+        _status_changed.wait(lock, [this]() { return _unfinished_threads_counter == 0; });
+    }
+
+    // brief: parks the calling thread until all launched threads are finished, but not longer than the timeout
+    // return: true if all launched threads are finished
+    [[nodiscard]] bool WaitForFinish(const std::chrono::milliseconds timeout) const {
+        std::unique_lock lock(_status_mutex);
+        return _status_changed.wait_for(lock, timeout, [this]() { return _unfinished_threads_counter == 0; });
     }
 };
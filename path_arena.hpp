@@ -0,0 +1,75 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: the component of path stored in PathArena-class: the name of an entry and the link to the component of its parent catalog
+// note: the root component keeps the full path of the initial catalog as the name
+struct PathNode {
+    const PathNode* parent;
+    size_t name_size;
+    // NOTE: the name is stored right after the node and is terminated by zero
+    const char* name() const noexcept {
+        return reinterpret_cast<const char*>(this + 1);
+    }
+
+    // NOTE: only the root component may end by the separator (the initial catalog "/")
+    bool IsEndedBySeparator() const noexcept {
+        return name_size && name()[name_size - 1] == fs::path::preferred_separator;
+    }
+
+    // brief: builds the full path by the chain of parent components
+    // note: the separator is not added after the parent component which already ends by it, so the walk of "/" gives "/etc" and not "//etc"
+    fs::path GetPath() const {
+        size_t path_size{ name_size };
+        for (const PathNode* node = this; node->parent; node = node->parent)
+            path_size += node->parent->name_size + !node->parent->IsEndedBySeparator();
+
+        std::string path(path_size, fs::path::preferred_separator);
+        for (const PathNode* node = this; node; node = node->parent) {
+            path_size -= node->name_size;
+            std::copy_n(node->name(), node->name_size, path.begin() + path_size);
+            if (node->parent && !node->parent->IsEndedBySeparator())
+                --path_size;
+        }
+        return fs::path(std::move(path));
+    }
+};
+
+// brief: append-only storage of path components
+// note: the instance is not thread-safe and it is owned by one walker, but the stored components are immutable and may be read by any thread
+class PathArena {
+    static constexpr size_t CHUNK_SIZE{ 64 * 1024 };
+
+    std::vector<std::unique_ptr<char[]>> _chunks{};
+    size_t _chunk_used{ CHUNK_SIZE };
+
+    char* _Allocate(const size_t size) {
+        if (size > CHUNK_SIZE) {
+            // NOTE: oversized component gets own chunk
+            _chunks.emplace_back(std::make_unique<char[]>(size));
+            _chunk_used = CHUNK_SIZE;
+            return _chunks.back().get();
+        }
+
+        if (_chunk_used + size > CHUNK_SIZE) {
+            _chunks.emplace_back(std::make_unique<char[]>(CHUNK_SIZE));
+            _chunk_used = 0;
+        }
+        char* result = _chunks.back().get() + _chunk_used;
+        _chunk_used += (size + alignof(PathNode) - 1) / alignof(PathNode) * alignof(PathNode);
+        return result;
+    }
+
+    public:
+    PathArena() = default;
+    PathArena(const PathArena&) = delete;
+    PathArena& operator=(const PathArena&) = delete;
+
+    const PathNode* Add(const PathNode* const parent, const std::string_view name) {
+        char* memory = _Allocate(sizeof(PathNode) + name.size() + 1);
+        PathNode* node = new (memory) PathNode{ parent, name.size() };
+        std::copy_n(name.data(), name.size(), memory + sizeof(PathNode));
+        memory[sizeof(PathNode) + name.size()] = '\0';
+        return node;
+    }
+};
@@ -2,61 +2,850 @@
 
 #include "stdafx.hpp"
 #include "parallel_executor.hpp"
+#include "walk_index.hpp"
+#include "walk_stats.hpp"
+#include "disk_usage.hpp"
+#include "walk_filter.hpp"
+#include "walk_control.hpp"
+#include "file_content.hpp"
+#include "bounded_channel.hpp"
+#include "directory_watcher.hpp"
+#include "worker_scaler.hpp"
+#include "work_stealing_queue.hpp"
+#include "directory_enumerator.hpp"
 
 enum class WALK_TYPE : uint8_t { LENGTH, WIDTH };
 
-template<WALK_TYPE Type = WALK_TYPE::WIDTH, PARALLELIZATION_BASE Base = PARALLELIZATION_BASE::STL_ALGORITHMS>
+// brief: the entry which is given by the stream of the walk (see RecursiveWalking::WalkInStream)
+struct StreamEntry {
+    size_t deep;
+    fs::path path;
+    bool is_directory;
+};
+
+// t-param: Type - the walk on length or on width
+// t-param: Base - target type to parallelization of walkers
+// t-param: Engine - the way to read entries of OS catalogs
+// t-param: IsInstrumented - to collect the statistics of walkers (see WalkStats-struct), WalkIn-method and WalkInEntries-method return them
+template<
+    WALK_TYPE Type = WALK_TYPE::WIDTH,
+    PARALLELIZATION_BASE Base = PARALLELIZATION_BASE::STL_ALGORITHMS,
+    ENUMERATION_ENGINE Engine = ENUMERATION_ENGINE::STD_FILESYSTEM,
+    bool IsInstrumented = false>
 class RecursiveWalking {
+    static_assert(Type == WALK_TYPE::LENGTH || Type == WALK_TYPE::WIDTH, "unknown type of walk through OS catalogs");
+
+    // NOTE: the walk on length takes the newest directory of a walker first, the walk on width - the oldest one
     // clang-format off
-    using WalkerCounter         = std::atomic_uint8_t;
-    using UnchekedDirectory     = std::tuple<size_t, fs::directory_entry>;
-    using ListUnchekedDirectory = ThreadSafeList<UnchekedDirectory>;
-    using ActionType            = std::function<void(size_t /*deep*/, const fs::path& /*full_file_path*/)>;
-    using OptActionType         = std::optional<ActionType>;
+    using EnumeratorType            = DirectoryEnumerator<Engine>;
+    using DirectoryType             = typename EnumeratorType::DirectoryType;
+    using EntryType                 = typename EnumeratorType::EntryType;
+    using OptEnumeratorType         = std::optional<EnumeratorType>;
+    using UnchekedDirectory         = std::tuple<size_t, DirectoryType>;
+    using QueueUnchekedDirectory    = WorkStealingQueue<UnchekedDirectory, Type == WALK_TYPE::LENGTH>;
+    using ActionType                = std::function<void(size_t /*deep*/, const fs::path& /*full_file_path*/)>;
+    using OptActionType             = std::optional<ActionType>;
+    using EntryActionType           = std::function<void(size_t /*deep*/, const EntryType& /*entry*/)>;
+    using OptEntryActionType        = std::optional<EntryActionType>;
+    using ControlledActionType      = std::function<WALK_DECISION(size_t /*deep*/, const fs::path& /*full_file_path*/)>;
+    using OptControlledActionType   = std::optional<ControlledActionType>;
+#ifdef __linux__
+    using BatchActionType           = std::function<void(size_t /*deep*/, const fs::path& /*full_dir_path*/, const EntriesView& /*entries*/)>;
+    using UsageDirectory            = std::tuple<size_t, DirectoryType, DiskUsageNode*>;
+    using QueueUsageDirectory       = WorkStealingQueue<UsageDirectory, Type == WALK_TYPE::LENGTH>;
+#endif
+    using ChannelType               = BoundedChannel<StreamEntry>;
+    using ContentActionType         = std::function<void(size_t /*deep*/, const fs::path& /*full_file_path*/, std::string_view /*content*/)>;
+    using FoundFile                 = std::tuple<size_t, fs::path>;
+    using FoundFilesChannel         = BoundedChannel<FoundFile>;
+    using ReadFile                  = std::tuple<size_t, fs::path, FileContent>;
+    using ReadFilesChannel          = BoundedChannel<ReadFile>;
+    using IncrementalActionType     = std::function<void(size_t /*deep*/, const fs::path& /*full_path*/, bool /*is_changed*/)>;
+    using OptIncrementalActionType  = std::optional<IncrementalActionType>;
+    using IncrementalDirectory      = std::tuple<size_t, fs::path>;
+    using QueueIncrementalDirectory = WorkStealingQueue<IncrementalDirectory, Type == WALK_TYPE::LENGTH>;
+    using TimerType                 = WalkStats::Timer<IsInstrumented>;
+    using WorkerStats               = WalkStats::WorkerStats;
+    using WalkResultType            = std::conditional_t<IsInstrumented, WalkStats, void>;
     // clang-format on
 
     size_t _deep;
     size_t _thread_quantity;
+    // NOTE: std::nullopt - the fixed quantity of walkers (see SetScaling-method)
+    std::optional<WalkScaling> _scaling{};
+    // NOTE: the resolved policy of all threads of walks (see SetLaunchPolicy-method)
+    LaunchPolicy _launch_policy{};
+    // NOTE: the spans of walkers are recorded in the statistics (see SetTracing-method)
+    bool _is_tracing{};
 
-    template<bool IsActionWithFile, bool IsActionWithDir>
-    void _Walker(
-        WalkerCounter& walker_counter,
-        ListUnchekedDirectory& unchecked_directories,
-        const ActionType* const action_with_file,
-        const ActionType* const action_with_dir) {
+    ParallelExecutor<Base> _MakeExecutor(const size_t threads_quantity) const {
+        ParallelExecutor<Base> executor{ threads_quantity };
+        executor.SetResolvedLaunchPolicy(_launch_policy);
+        return executor;
+    }
+
+    // brief: parks the walker until a catalog appears, the walker with adaptive quantity of walkers is parked not longer than retire_delay
+    // | and then it is retired if there are more active walkers than min_workers
+    // return: the catalog or std::nullopt if the walk is finished or the walker is retired
+    static std::optional<UnchekedDirectory> _WaitDirectory(
+        QueueUnchekedDirectory& unchecked_directories, const size_t worker_index, WorkerScaler* const scaler) {
+        if (!scaler)
+            return unchecked_directories.ExtractOrWait(worker_index);
         while (true) {
-            if (std::optional<UnchekedDirectory> unchecked_directory{ unchecked_directories.ExtractFront() }; unchecked_directory.has_value()) {
-                ++walker_counter;
-                auto [current_deep, current_dir] = unchecked_directory.value();
-                for (const fs::directory_entry& sub_dir : fs::directory_iterator(current_dir, fs::directory_options::skip_permission_denied)) {
+            if (std::optional<UnchekedDirectory> result{ unchecked_directories.ExtractOrWaitFor(worker_index, scaler->GetRetireDelay()) })
+                return result;
+            if (unchecked_directories.IsFinished() || scaler->TryRetire())
+                return std::nullopt;
+        }
+    }
+
+    // brief: extracts the catalog for the walker like WorkStealingQueue::ExtractOrWait,
+    // | but in instrumentation mode divides the time of the extraction to the time of the queue and the idle time
+    std::optional<UnchekedDirectory> _ExtractDirectory(
+        QueueUnchekedDirectory& unchecked_directories, const size_t worker_index, WalkStats* const stats, WorkerScaler* const scaler) {
+        if constexpr (IsInstrumented) {
+            std::optional<UnchekedDirectory> result{};
+            {
+                TimerType queue_timer(stats, worker_index, &WorkerStats::lock_wait_ns);
+                result = unchecked_directories.Extract(worker_index);
+            }
+            if (!result.has_value()) {
+                TimerType idle_timer(stats, worker_index, &WorkerStats::idle_ns, "idle");
+                result = _WaitDirectory(unchecked_directories, worker_index, scaler);
+            }
+            if (result.has_value())
+                ++stats->workers[worker_index].pops;
+            return result;
+        } else {
+            return _WaitDirectory(unchecked_directories, worker_index, scaler);
+        }
+    }
+
+    // t-param: CallbackType - ActionType (the action gets full path), EntryActionType (the action gets the entry of catalog)
+    // | or ControlledActionType (the action gets full path and returns WALK_DECISION)
+    // t-param: IsFiltered - to check the entries by the filter, without it the walker has no code of the filter
+    // note: stats - the statistics of walkers, it is used only in instrumentation mode
+    // note: filter - the filter of entries, it is used only with IsFiltered
+    // note: control - the state of the controlled walk, it is used only with ControlledActionType
+    // note: scaler - the scaler of the adaptive quantity of walkers, nullptr - the quantity of walkers is fixed
+    // note: slot_enumerators - the enumerators of the slots of the scaler (see _LaunchAdaptive-method), it is used only with the scaler
+    template<bool IsActionWithFile, bool IsActionWithDir, class CallbackType, bool IsFiltered>
+    void _Walker(
+        QueueUnchekedDirectory& unchecked_directories,
+        const CallbackType* const action_with_file,
+        const CallbackType* const action_with_dir,
+        WalkStats* const stats,
+        const CompiledWalkFilter* const filter,
+        WalkControl* const control,
+        WorkerScaler* const scaler,
+        OptEnumeratorType* const slot_enumerators) {
+        constexpr bool IsEntryAction = std::is_same_v<CallbackType, EntryActionType>;
+        constexpr bool IsControlled = std::is_same_v<CallbackType, ControlledActionType>;
+        // NOTE: the sub catalogs of the scanned catalog are added to the queue by one locking
+        std::vector<UnchekedDirectory> sub_directories{};
+        // NOTE: the entries of the walker for the periodic check of the deadline (see WalkControl::CheckEntry)
+        size_t checked_entries{};
+
+        // NOTE: the added walker takes the slot of the retired one, so the deques, the statistics and the enumerators are not shared by walkers
+        const size_t worker_index = scaler ? scaler->AcquireSlot() : unchecked_directories.RegisterWorker();
+        OptEnumeratorType own_enumerator{};
+        OptEnumeratorType& slot_enumerator = scaler ? slot_enumerators[worker_index] : own_enumerator;
+        if (!slot_enumerator.has_value())
+            slot_enumerator.emplace();
+        EnumeratorType& enumerator = slot_enumerator.value();
+        while (std::optional<UnchekedDirectory> unchecked_directory{ _ExtractDirectory(unchecked_directories, worker_index, stats, scaler) }) {
+            auto& [current_deep, current_dir] = unchecked_directory.value();
+            // NOTE: the stopped walk drops the catalogs of the queue, the extracted catalogs are completed without the scan
+            if constexpr (IsControlled)
+                if (control->Check()) {
+                    unchecked_directories.Clear();
+                    unchecked_directories.CompleteTask();
+                    continue;
+                }
+            const auto scan_start = scaler ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+            bool is_rest_skipped{ false };
+            {
+                TimerType scan_timer(stats, worker_index, &WorkerStats::enumeration_ns, "scan");
+                enumerator.ForEach(current_dir, [&, current_deep = current_deep](const EntryType& sub_dir) {
+                    if constexpr (IsInstrumented)
+                        ++stats->workers[worker_index].entries;
+                    if constexpr (IsControlled)
+                        if (is_rest_skipped || control->CheckEntry(checked_entries))
+                            return;
+
                     if (!sub_dir.is_directory()) {
-                        if constexpr (IsActionWithFile)
+                        if constexpr (IsFiltered && IsActionWithFile)
+                            if (!filter->IsFileMatched(sub_dir))
+                                return;
+                        TimerType action_timer(stats, worker_index, &WorkerStats::action_ns);
+                        if constexpr (IsActionWithFile && IsControlled) {
+                            if (!control->TakeEntry())
+                                return;
+                            const WALK_DECISION decision = (*action_with_file)(current_deep, sub_dir.path());
+                            is_rest_skipped = decision == WALK_DECISION::SKIP_SUBTREE;
+                            if (decision == WALK_DECISION::STOP)
+                                control->Stop(WALK_STOP_REASON::STOPPED_BY_ACTION);
+                        } else if constexpr (IsActionWithFile && IsEntryAction) {
+                            (*action_with_file)(current_deep, sub_dir);
+                        } else if constexpr (IsActionWithFile) {
                             (*action_with_file)(current_deep, sub_dir.path());
+                        }
 
                     } else if (current_deep < _deep) {
-                        if constexpr (IsActionWithDir)
-                            (*action_with_dir)(current_deep, sub_dir.path());
-
-                        UnchekedDirectory unchecked_element = std::make_tuple(current_deep + 1, sub_dir);
-                        if constexpr (Type == WALK_TYPE::LENGTH) {
-                            unchecked_directories.emplace_front(std::move(unchecked_element));
-                        } else if constexpr (Type == WALK_TYPE::WIDTH) {
-                            unchecked_directories.emplace_back(std::move(unchecked_element));
-                        } else {
-                            static_assert(false, "unknown type of walk through OS catalogs");
+                        // NOTE: the excluded catalog is not given to the action and is not added to the queue, so it is never opened
+                        if constexpr (IsFiltered)
+                            if (filter->IsDirectoryExcluded(sub_dir))
+                                return;
+                        DirectoryType sub_dir_element{ enumerator.ToDirectory(sub_dir) };
+                        {
+                            TimerType action_timer(stats, worker_index, &WorkerStats::action_ns);
+                            if constexpr (IsActionWithDir && IsControlled) {
+                                if (!control->TakeEntry())
+                                    return;
+                                const WALK_DECISION decision = (*action_with_dir)(current_deep, enumerator.GetPath(sub_dir_element));
+                                if (decision == WALK_DECISION::STOP)
+                                    control->Stop(WALK_STOP_REASON::STOPPED_BY_ACTION);
+                                if (decision != WALK_DECISION::CONTINUE)
+                                    return;
+                            } else if constexpr (IsActionWithDir && IsEntryAction) {
+                                (*action_with_dir)(current_deep, sub_dir);
+                            } else if constexpr (IsActionWithDir) {
+                                (*action_with_dir)(current_deep, enumerator.GetPath(sub_dir_element));
+                            }
                         }
+                        sub_directories.emplace_back(current_deep + 1, std::move(sub_dir_element));
                     }
-                }
-                --walker_counter;
-            } else if (walker_counter) {
-                std::this_thread::yield();
-            } else {
+                });
+            }
+            if constexpr (IsControlled)
+                if (control->IsStopped())
+                    sub_directories.clear();
+            if constexpr (IsInstrumented) {
+                ++stats->workers[worker_index].directories;
+                stats->workers[worker_index].pushes += sub_directories.size();
+            }
+            {
+                TimerType queue_timer(stats, worker_index, &WorkerStats::lock_wait_ns);
+                unchecked_directories.EmplaceRange(
+                    worker_index, std::make_move_iterator(sub_directories.begin()), std::make_move_iterator(sub_directories.end()));
+            }
+            sub_directories.clear();
+            if (scaler)
+                scaler->OnScanned(unchecked_directories.size(), std::chrono::steady_clock::now() - scan_start);
+            unchecked_directories.CompleteTask();
+        }
+        if (scaler)
+            scaler->ReleaseSlot(worker_index);
+    }
+
+    void _StreamWalker(QueueUnchekedDirectory& unchecked_directories, ChannelType* const channel) {
+        EnumeratorType enumerator{};
+        const size_t worker_index = unchecked_directories.RegisterWorker();
+        while (std::optional<UnchekedDirectory> unchecked_directory{ unchecked_directories.ExtractOrWait(worker_index) }) {
+            auto& [current_deep, current_dir] = unchecked_directory.value();
+            // NOTE: after closing of the channel by the consumer the rest of catalogs are only completed without scanning
+            if (!channel->IsClosed()) {
+                enumerator.ForEach(current_dir, [&, current_deep = current_deep](const EntryType& sub_dir) {
+                    if (!sub_dir.is_directory()) {
+                        channel->Emplace(StreamEntry{ current_deep, sub_dir.path(), false });
+                    } else if (current_deep < _deep) {
+                        DirectoryType sub_dir_element{ enumerator.ToDirectory(sub_dir) };
+                        if (channel->Emplace(StreamEntry{ current_deep, enumerator.GetPath(sub_dir_element), true }))
+                            unchecked_directories.Emplace(worker_index, current_deep + 1, std::move(sub_dir_element));
+                    }
+                });
+            }
+            unchecked_directories.CompleteTask();
+        }
+        // NOTE: all catalogs are completed, so all entries are already in the channel
+        channel->Close();
+    }
+
+    // brief: the catalog of the sorted walk (see WalkInSorted-method), it is scanned by the walker or by the emitter which claims it first
+    struct SortedNode {
+        enum STATE : uint8_t { PENDING, CLAIMED, SCANNED };
+
+        size_t deep;
+        DirectoryType directory;
+        std::atomic<uint8_t> state{ PENDING };
+        // NOTE: the entries are sorted by name, the node of the sub catalog is set only if the sub catalog is entered
+        std::vector<std::pair<fs::path, std::shared_ptr<SortedNode>>> entries{};
+
+        SortedNode(const size_t node_deep, DirectoryType node_directory)
+            : deep{ node_deep }
+            , directory{ std::move(node_directory) } {}
+    };
+
+    // NOTE: the node is owned by the tree and by the queue, because the emitter may release the scanned node before the walker extracts it
+    using SortedNodePtr = std::shared_ptr<SortedNode>;
+
+    // brief: the state of the sorted walk which is shared by the walkers and the emitter
+    struct SortedWalkState {
+        // NOTE: the newest catalog first, so the walkers scan ahead of the emitter in the same order as it emits
+        WorkStealingQueue<SortedNodePtr, true> nodes;
+        size_t capacity;
+        // NOTE: the entries which are scanned, but not emitted yet
+        std::atomic_size_t buffered_entries{};
+        std::atomic_size_t parked_walkers{};
+        std::atomic_bool is_emitter_waiting{ false };
+        std::atomic_bool is_emitted{ false };
+        std::mutex mutex{};
+        std::condition_variable scanned{};
+        std::condition_variable drained{};
+        // NOTE: the enumerators of the walkers and of the emitter live until the end of the walk, because the queued catalogs
+        // | and the paths of the tree keep the data of the enumerator which has found them (see PathArena-class)
+        std::unique_ptr<OptEnumeratorType[]> enumerators;
+        std::atomic_size_t next_enumerator{};
+
+        SortedWalkState(const size_t walkers_quantity, const size_t buffer_capacity)
+            : nodes{ walkers_quantity }
+            , capacity{ buffer_capacity }
+            , enumerators{ std::make_unique<OptEnumeratorType[]>(walkers_quantity + 1) } {}
+
+        EnumeratorType& TakeEnumerator() {
+            return enumerators[next_enumerator++].emplace();
+        }
+    };
+
+    // brief: scans the claimed catalog, sorts its entries and adds its sub catalogs to the queue
+    void _ScanSortedNode(EnumeratorType& enumerator, SortedNode& node, SortedWalkState& state, const size_t worker_index) {
+        enumerator.ForEach(node.directory, [&](const EntryType& sub_dir) {
+            if (!sub_dir.is_directory()) {
+                node.entries.emplace_back(sub_dir.path(), nullptr);
+            } else if (node.deep < _deep) {
+                DirectoryType sub_dir_element{ enumerator.ToDirectory(sub_dir) };
+                fs::path sub_dir_path{ enumerator.GetPath(sub_dir_element) };
+                node.entries.emplace_back(std::move(sub_dir_path), std::make_shared<SortedNode>(node.deep + 1, std::move(sub_dir_element)));
+            }
+        });
+        // NOTE: all entries have the same parent, so the comparison of full paths is the comparison of names
+        std::sort(node.entries.begin(), node.entries.end(), [](const auto& left, const auto& right) { return left.first.native() < right.first.native(); });
+
+        // NOTE: the sub catalogs are added from the last one, so the first of them is extracted first
+        std::vector<SortedNodePtr> sub_nodes{};
+        for (auto it = node.entries.rbegin(); it != node.entries.rend(); ++it)
+            if (it->second)
+                sub_nodes.push_back(it->second);
+        state.nodes.EmplaceRange(worker_index, std::make_move_iterator(sub_nodes.begin()), std::make_move_iterator(sub_nodes.end()));
+
+        state.buffered_entries += node.entries.size();
+        node.state = SortedNode::SCANNED;
+        if (state.is_emitter_waiting) {
+            std::lock_guard lock(state.mutex);
+            state.scanned.notify_all();
+        }
+    }
+
+    void _SortedWalker(SortedWalkState* const state) {
+        EnumeratorType& enumerator = state->TakeEnumerator();
+        const size_t worker_index = state->nodes.RegisterWorker();
+        while (std::optional<SortedNodePtr> node{ state->nodes.ExtractOrWait(worker_index) }) {
+            uint8_t expected{ SortedNode::PENDING };
+            if (node.value()->state.compare_exchange_strong(expected, SortedNode::CLAIMED))
+                _ScanSortedNode(enumerator, *node.value(), *state, worker_index);
+            node.reset();
+            state->nodes.CompleteTask();
+
+            // NOTE: the walker is parked while the emitter is behind by more than the capacity, the emitter scans the catalogs which it needs itself
+            if (state->buffered_entries > state->capacity && !state->is_emitted) {
+                std::unique_lock lock(state->mutex);
+                ++state->parked_walkers;
+                state->drained.wait(lock, [state]() { return state->buffered_entries <= state->capacity || state->is_emitted; });
+                --state->parked_walkers;
+            }
+        }
+    }
+
+    // brief: gives the entries of the tree to the actions in the order of the walk on length with sorted entries of every catalog,
+    // | the catalog which is needed, but is not claimed by walkers yet, is scanned by the emitter itself
+    void _EmitSorted(const SortedNodePtr& root, SortedWalkState& state, const ActionType* const action_with_file, const ActionType* const action_with_dir) {
+        EnumeratorType& enumerator = state.TakeEnumerator();
+        const size_t emitter_index = state.nodes.RegisterWorker();
+        auto wait_scanned = [&](SortedNode& node) {
+            uint8_t expected{ SortedNode::PENDING };
+            if (node.state.compare_exchange_strong(expected, SortedNode::CLAIMED))
+                return _ScanSortedNode(enumerator, node, state, emitter_index);
+            if (node.state == SortedNode::SCANNED)
                 return;
+            std::unique_lock lock(state.mutex);
+            state.is_emitter_waiting = true;
+            state.scanned.wait(lock, [&node]() { return node.state == SortedNode::SCANNED; });
+            state.is_emitter_waiting = false;
+        };
+
+        // NOTE: the stack of catalogs from the root to the emitted one with the index of the next entry of every catalog
+        std::vector<std::pair<SortedNodePtr, size_t>> stack{};
+        wait_scanned(*root);
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            SortedNode& node = *stack.back().first;
+            const size_t index = stack.back().second++;
+            if (index == node.entries.size()) {
+                stack.pop_back();
+                continue;
+            }
+
+            auto& [path, sub_node] = node.entries[index];
+            if (sub_node && action_with_dir)
+                (*action_with_dir)(node.deep, path);
+            else if (!sub_node && action_with_file)
+                (*action_with_file)(node.deep, path);
+            if (--state.buffered_entries <= state.capacity && state.parked_walkers) {
+                std::lock_guard lock(state.mutex);
+                state.drained.notify_all();
+            }
+
+            if (sub_node) {
+                SortedNodePtr next{ std::move(sub_node) };
+                wait_scanned(*next);
+                stack.emplace_back(std::move(next), 0);
+            }
+        }
+    }
+
+    // brief: the first stage of the content pipeline (see WalkInContent-method): finds the files and gives them to the readers
+    void _ContentWalker(QueueUnchekedDirectory& unchecked_directories, FoundFilesChannel* const found_files) {
+        EnumeratorType enumerator{};
+        std::vector<UnchekedDirectory> sub_directories{};
+        const size_t worker_index = unchecked_directories.RegisterWorker();
+        while (std::optional<UnchekedDirectory> unchecked_directory{ unchecked_directories.ExtractOrWait(worker_index) }) {
+            auto& [current_deep, current_dir] = unchecked_directory.value();
+            enumerator.ForEach(current_dir, [&, current_deep = current_deep](const EntryType& sub_dir) {
+                if (!sub_dir.is_directory())
+                    found_files->Emplace(current_deep, sub_dir.path());
+                else if (current_deep < _deep)
+                    sub_directories.emplace_back(current_deep + 1, enumerator.ToDirectory(sub_dir));
+            });
+            unchecked_directories.EmplaceRange(
+                worker_index, std::make_move_iterator(sub_directories.begin()), std::make_move_iterator(sub_directories.end()));
+            sub_directories.clear();
+            unchecked_directories.CompleteTask();
+        }
+        // NOTE: all catalogs are completed, so all files are already in the channel
+        found_files->Close();
+    }
+
+    // brief: the second stage of the content pipeline: reads the found files and gives their contents to the processors
+    // note: the files which can not be read (no access, removed after the finding, not regular) are skipped
+    static void _ContentReader(
+        FoundFilesChannel* const found_files, ReadFilesChannel* const read_files, const CONTENT_READING reading, std::atomic_size_t* const unfinished_readers) {
+        while (std::optional<FoundFile> found_file{ found_files->Extract() }) {
+            auto& [deep, path] = found_file.value();
+            if (std::optional<FileContent> content{ FileContent::Read(path, reading) })
+                read_files->Emplace(deep, std::move(path), std::move(content.value()));
+        }
+        // NOTE: the last finished reader closes the channel, so the processors finish after all read files
+        if (--*unfinished_readers == 0)
+            read_files->Close();
+    }
+
+    // brief: the last stage of the content pipeline: calls the action with the view of the content of every read file
+    static void _ContentProcessor(ReadFilesChannel* const read_files, const ContentActionType* const action) {
+        while (std::optional<ReadFile> read_file{ read_files->Extract() }) {
+            const auto& [deep, path, content] = read_file.value();
+            (*action)(deep, path, content.View());
+        }
+    }
+
+    void _IncrementalWalker(
+        QueueIncrementalDirectory& unchecked_directories,
+        const WalkIndex* const previous_index,
+        WalkIndexBuilder* const current_index,
+        const IncrementalActionType* const action_with_file,
+        const IncrementalActionType* const action_with_dir) {
+        std::vector<WalkIndexBuilder::Record> records{};
+        std::vector<IncrementalDirectory> sub_directories{};
+
+        EnumeratorType enumerator{};
+        const size_t worker_index = unchecked_directories.RegisterWorker();
+        while (std::optional<IncrementalDirectory> unchecked_directory{ unchecked_directories.ExtractOrWait(worker_index) }) {
+            auto& [current_deep, current_dir] = unchecked_directory.value();
+            auto visit = [&, current_deep = current_deep](fs::path&& sub_path, const bool is_directory, const bool is_changed) {
+                if (!is_directory) {
+                    if (action_with_file)
+                        (*action_with_file)(current_deep, sub_path, is_changed);
+                } else if (current_deep < _deep) {
+                    if (action_with_dir)
+                        (*action_with_dir)(current_deep, sub_path, is_changed);
+                    sub_directories.emplace_back(current_deep + 1, std::move(sub_path));
+                }
+            };
+
+            // NOTE: the stamp is taken before the scan, so the changes made during the scan will be found by the next walk
+            if (const std::optional<DirectoryStamp> stamp{ DirectoryStamp::Get(current_dir) }; stamp.has_value()) {
+                WalkIndexBuilder::Record& record = records.emplace_back(WalkIndexBuilder::Record{ current_dir.string(), {}, 0, {} });
+                if (const std::optional<WalkIndex::DirectoryRecord> previous{ previous_index->Find(record.path) };
+                    previous.has_value() && previous->stamp == stamp.value()) {
+                    record.stamp = previous->stamp;
+                    record.entries_quantity = previous->entries_quantity;
+                    record.entries = previous->entries;
+                    previous->ForEach([&](const std::string_view name, const bool is_directory) { visit(current_dir / name, is_directory, false); });
+                } else {
+                    record.stamp = current_index->IsReliable(stamp.value()) ? stamp.value() : DirectoryStamp{};
+                    enumerator.ForEach(enumerator.ToDirectory(fs::directory_entry(current_dir)), [&](const EntryType& sub_dir) {
+                        fs::path sub_path{ sub_dir.path() };
+                        record.AddEntry(sub_path.filename().string(), sub_dir.is_directory());
+                        visit(std::move(sub_path), sub_dir.is_directory(), true);
+                    });
+                }
+            }
+            unchecked_directories.EmplaceRange(
+                worker_index, std::make_move_iterator(sub_directories.begin()), std::make_move_iterator(sub_directories.end()));
+            sub_directories.clear();
+            unchecked_directories.CompleteTask();
+        }
+        current_index->Merge(std::move(records));
+    }
+
+    // clang-format off
+    using StreamUnitType = decltype(std::declval<ParallelExecutor<Base>&>().Launch(
+        &RecursiveWalking::_StreamWalker,
+        std::declval<RecursiveWalking*>(),
+        std::declval<std::reference_wrapper<QueueUnchekedDirectory>>(),
+        std::declval<ChannelType*>()));
+    // clang-format on
+
+#ifdef __linux__
+    // brief: the storages of the batch of entries of one catalog, they are reused by the walker for all its catalogs
+    struct BatchStorage {
+        std::vector<EntryInfo> entries{};
+        std::string names{};
+        std::vector<size_t> names_offsets{};
+    };
+
+    // brief: scans the catalog into the storage, on_sub_dir(sub_dir) is called for every sub catalog right after its entry is added to the storage
+    // t-param: IsWithMetadata - to fill the metadata of entries by statx, the metadata is ready only after the return
+    template<bool IsWithMetadata, class SubDirActionType>
+    static void _ScanBatch(EnumeratorType& enumerator, const DirectoryType& current_dir, BatchStorage& storage, SubDirActionType&& on_sub_dir) {
+        storage.entries.clear();
+        storage.names.clear();
+        storage.names_offsets.clear();
+        auto on_entry = [&](const EntryType& sub_dir) {
+            const std::string_view name{ sub_dir.name() };
+            EntryInfo& info = storage.entries.emplace_back();
+            // NOTE: the name is bound to the storage of names only after the scan of the catalog, because the storage may be reallocated;
+            // | the names are terminated by zero, so they can be passed to syscalls
+            storage.names_offsets.push_back(storage.names.size());
+            storage.names.append(name).push_back('\0');
+            info.inode = sub_dir.inode();
+            info.type = sub_dir.type();
+            info.is_directory = sub_dir.is_directory();
+            if constexpr (IsWithMetadata && Engine != ENUMERATION_ENGINE::LINUX_IO_URING)
+                info.FillMetadata(sub_dir.dir_fd(), name.data());
+
+            if (sub_dir.is_directory())
+                on_sub_dir(sub_dir);
+        };
+        auto bind_names = [&]() {
+            storage.names_offsets.push_back(storage.names.size());
+            for (size_t i{ 0 }; i < storage.entries.size(); ++i)
+                storage.entries[i].name = std::string_view(
+                    storage.names.data() + storage.names_offsets[i], storage.names_offsets[i + 1] - storage.names_offsets[i] - 1);
+        };
+        if constexpr (IsWithMetadata && Engine == ENUMERATION_ENGINE::LINUX_IO_URING) {
+            // NOTE: the metadata of all entries of the catalog is read by the operations in flight while the catalog is still opened
+            enumerator.ForEach(current_dir, on_entry, [&](const int dir_fd) {
+                bind_names();
+                enumerator.FillMetadata(dir_fd, storage.entries.data(), storage.entries.size());
+            });
+        } else {
+            enumerator.ForEach(current_dir, on_entry);
+            bind_names();
+        }
+    }
+
+    template<bool IsWithMetadata>
+    void _BatchWalker(QueueUnchekedDirectory& unchecked_directories, const BatchActionType* const action) {
+        BatchStorage storage{};
+        std::vector<UnchekedDirectory> sub_directories{};
+
+        EnumeratorType enumerator{};
+        const size_t worker_index = unchecked_directories.RegisterWorker();
+        while (std::optional<UnchekedDirectory> unchecked_directory{ unchecked_directories.ExtractOrWait(worker_index) }) {
+            auto& [current_deep, current_dir] = unchecked_directory.value();
+            _ScanBatch<IsWithMetadata>(enumerator, current_dir, storage, [&, current_deep = current_deep](const EntryType& sub_dir) {
+                if (current_deep < _deep)
+                    sub_directories.emplace_back(current_deep + 1, enumerator.ToDirectory(sub_dir));
+            });
+            unchecked_directories.EmplaceRange(
+                worker_index, std::make_move_iterator(sub_directories.begin()), std::make_move_iterator(sub_directories.end()));
+            sub_directories.clear();
+
+            (*action)(current_deep, enumerator.GetPath(current_dir), EntriesView{ storage.entries.data(), storage.entries.size() });
+            unchecked_directories.CompleteTask();
+        }
+    }
+
+    // brief: the walker of the disk usage (see WalkInUsage-method): sums the entries of every catalog into its node or into the node of its ancestor
+    // | at the limit of deep, and reports the finish of the scan to the node (see DiskUsageNode::Complete)
+    void _UsageWalker(QueueUsageDirectory& usage_directories, InodeSet* const inodes) {
+        BatchStorage storage{};
+        std::vector<UsageDirectory> sub_directories{};
+        // NOTE: the indexes of entries of the queued sub catalogs in the storage
+        std::vector<size_t> sub_indexes{};
+
+        EnumeratorType enumerator{};
+        const size_t worker_index = usage_directories.RegisterWorker();
+        while (std::optional<UsageDirectory> usage_directory{ usage_directories.ExtractOrWait(worker_index) }) {
+            auto& [current_deep, current_dir, current_node] = usage_directory.value();
+            _ScanBatch<true>(enumerator, current_dir, storage, [&, current_deep = current_deep, current_node = current_node](const EntryType& sub_dir) {
+                // NOTE: the symbolic link to the catalog is not followed, it is counted as a file
+                if (sub_dir.type() == DT_LNK)
+                    return;
+                DiskUsageNode* sub_node = current_node;
+                if (current_deep < _deep)
+                    sub_node = current_node->children.emplace_back(std::make_unique<DiskUsageNode>(current_node, sub_dir.name())).get();
+                sub_indexes.push_back(storage.entries.size() - 1);
+                sub_directories.emplace_back(current_deep + 1, enumerator.ToDirectory(sub_dir), sub_node);
+            });
+
+            // NOTE: the sub catalog is counted by its own node before it is queued, so its subtree can not be finished without it
+            DiskUsageTotals own{};
+            for (size_t i{ 0 }, sub{ 0 }; i < storage.entries.size(); ++i) {
+                const EntryInfo& info = storage.entries[i];
+                if (sub < sub_indexes.size() && sub_indexes[sub] == i) {
+                    DiskUsageNode* const sub_node = std::get<2>(sub_directories[sub++]);
+                    const DiskUsageTotals sub_dir_totals{ info.size, info.blocks, 0, 1 };
+                    if (sub_node == current_node)
+                        own += sub_dir_totals;
+                    else
+                        sub_node->Add(sub_dir_totals);
+                } else if (info.links < 2 || inodes->Insert(info.device, info.inode)) {
+                    own += DiskUsageTotals{ info.size, info.blocks, 1, 0 };
+                }
             }
+            current_node->Add(own);
+            current_node->pending.fetch_add(sub_directories.size(), std::memory_order_relaxed);
+            usage_directories.EmplaceRange(
+                worker_index, std::make_move_iterator(sub_directories.begin()), std::make_move_iterator(sub_directories.end()));
+            sub_directories.clear();
+            sub_indexes.clear();
+
+            DiskUsageNode::Complete(current_node);
+            usage_directories.CompleteTask();
+        }
+    }
+#endif
+
+    static fs::directory_entry _GetInitialDirectory(const fs::path& catalog) {
+        fs::directory_entry initial_dir{ catalog };
+
+        if (!static_cast<fs::directory_entry>(initial_dir).is_directory())
+            throw std::exception("initial directory is not OS catalog");
+        return initial_dir;
+    }
+
+    // brief: launches the walkers from the initial catalog and waits while all of them are finished
+    template<class RealWalkerType, class... ArgsTypes>
+    void _Launch(const fs::directory_entry& initial_dir, RealWalkerType real_walker, ArgsTypes... args) {
+        // NOTE: the enumerator of the initial catalog must live until the end of the walk, because it may own the data of the initial catalog
+        EnumeratorType initial_enumerator{};
+        QueueUnchekedDirectory unchecked_directories{ _thread_quantity };
+        unchecked_directories.Emplace(0, 0, initial_enumerator.ToDirectory(initial_dir));
+        _MakeExecutor(_thread_quantity).Launch(real_walker, this, std::ref(unchecked_directories), args...).WaitWhileAllFinished();
+    }
+
+    // brief: launches min_workers walkers from the initial catalog, the walkers add and retire each other (see WorkerScaler-class),
+    // | and waits while all of them are finished
+    // return: the maximal quantity of walkers which worked at the same time
+    template<class RealWalkerType, class... ArgsTypes>
+    size_t _LaunchAdaptive(const fs::directory_entry& initial_dir, RealWalkerType real_walker, ArgsTypes... args) {
+        EnumeratorType initial_enumerator{};
+        // NOTE: the catalogs which are queued by the retired walker keep the data of its enumerator (see PathArena-class),
+        // | so the enumerator of every slot lives until the end of the walk and is taken by the next walker of the slot
+        const std::unique_ptr<OptEnumeratorType[]> slot_enumerators{ std::make_unique<OptEnumeratorType[]>(_scaling->max_workers) };
+        QueueUnchekedDirectory unchecked_directories{ _scaling->max_workers };
+        unchecked_directories.Emplace(0, 0, initial_enumerator.ToDirectory(initial_dir));
+        WorkerScaler scaler{ _scaling.value() };
+        std::atomic_size_t next_worker{};
+        scaler.Run([&, this]() {
+            const LaunchPolicy::ThreadScope policy_scope{ _launch_policy, next_worker++ };
+            (this->*real_walker)(unchecked_directories, args..., &scaler, slot_enumerators.get());
+        });
+        return scaler.GetPeakWorkers();
+    }
+
+    template<class CallbackType>
+    using RealWalkerType = void (RecursiveWalking::*)(
+        QueueUnchekedDirectory&,
+        const CallbackType* const,
+        const CallbackType* const,
+        WalkStats* const,
+        const CompiledWalkFilter* const,
+        WalkControl* const,
+        WorkerScaler* const,
+        OptEnumeratorType* const);
+
+    template<class CallbackType, bool IsFiltered>
+    static RealWalkerType<CallbackType> _SelectWalker(const bool is_f, const bool is_d) {
+        if (is_f && is_d)
+            return &RecursiveWalking::_Walker<true, true, CallbackType, IsFiltered>;
+        else if (is_f && !is_d)
+            return &RecursiveWalking::_Walker<true, false, CallbackType, IsFiltered>;
+        else if (!is_f && is_d)
+            return &RecursiveWalking::_Walker<false, true, CallbackType, IsFiltered>;
+        else
+            throw std::exception("at least one action (with files or with directory) must be assigned");
+    }
+
+    // note: filter - the filter of entries, nullptr - all entries are given to the actions
+    // note: control - the state of the controlled walk, it is used only with ControlledActionType
+    template<class CallbackType>
+    WalkResultType _WalkIn(
+        const fs::path& catalog,
+        const std::optional<CallbackType>& action_with_file,
+        const std::optional<CallbackType>& action_with_dir,
+        const WalkFilter* const filter,
+        WalkControl* const control = nullptr) {
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+
+        // NOTE: the filter is compiled once per walk and is shared by all walkers
+        const std::optional<CompiledWalkFilter> compiled_filter{ filter ? std::make_optional<CompiledWalkFilter>(*filter) : std::nullopt };
+        const CompiledWalkFilter* const filter_ptr = compiled_filter.has_value() ? &compiled_filter.value() : nullptr;
+        const bool is_f = action_with_file.has_value(), is_d = action_with_dir.has_value();
+        const RealWalkerType<CallbackType> RealWalker = filter ? _SelectWalker<CallbackType, true>(is_f, is_d) : _SelectWalker<CallbackType, false>(is_f, is_d);
+
+        const CallbackType* const action_file_ptr = action_with_file.has_value() ? &action_with_file.operator*() : nullptr;
+        const CallbackType* const action_dir_ptr = action_with_dir.has_value() ? &action_with_dir.operator*() : nullptr;
+        if constexpr (IsInstrumented) {
+            WalkStats stats{ _scaling.has_value() ? _scaling->max_workers : _thread_quantity, _is_tracing };
+            if (_scaling.has_value())
+                stats.peak_workers = _LaunchAdaptive(initial_dir, RealWalker, action_file_ptr, action_dir_ptr, &stats, filter_ptr, control);
+            else
+                _Launch(
+                    initial_dir,
+                    RealWalker,
+                    action_file_ptr,
+                    action_dir_ptr,
+                    &stats,
+                    filter_ptr,
+                    control,
+                    static_cast<WorkerScaler*>(nullptr),
+                    static_cast<OptEnumeratorType*>(nullptr));
+            stats.Finish();
+            return stats;
+        } else {
+            if (_scaling.has_value())
+                _LaunchAdaptive(initial_dir, RealWalker, action_file_ptr, action_dir_ptr, static_cast<WalkStats*>(nullptr), filter_ptr, control);
+            else
+                _Launch(
+                    initial_dir,
+                    RealWalker,
+                    action_file_ptr,
+                    action_dir_ptr,
+                    static_cast<WalkStats*>(nullptr),
+                    filter_ptr,
+                    control,
+                    static_cast<WorkerScaler*>(nullptr),
+                    static_cast<OptEnumeratorType*>(nullptr));
         }
     }
 
     public:
+    // brief: the result of WalkInStream-method: the walkers scan catalogs in background and the caller reads entries at its own pace
+    // note: the walkers are parked while the channel of entries is full, so the memory does not grow with the size of the tree
+    // note: the destruction of the stream before reading of all entries stops the walk
+    class WalkStream {
+        friend class RecursiveWalking;
+
+        struct State {
+            // NOTE: the copy of the walking object is used by walkers, so the stream does not depend on the lifetime of the original object
+            RecursiveWalking walking;
+            ChannelType channel;
+            EnumeratorType initial_enumerator{};
+            QueueUnchekedDirectory unchecked_directories;
+            // NOTE: the unit must be the last member, because its destruction waits while all walkers are finished
+            StreamUnitType unit;
+
+            State(const RecursiveWalking& original, const fs::directory_entry& initial_dir, const size_t capacity)
+                : walking{ original }
+                , channel{ capacity }
+                , unchecked_directories{ original._thread_quantity }
+                , unit{ _Start(initial_dir) } {}
+
+            ~State() {
+                channel.Close();
+            }
+
+            StreamUnitType _Start(const fs::directory_entry& initial_dir) {
+                unchecked_directories.Emplace(0, 0, initial_enumerator.ToDirectory(initial_dir));
+                return walking._MakeExecutor(walking._thread_quantity).Launch(
+                    &RecursiveWalking::_StreamWalker, &walking, std::ref(unchecked_directories), &channel);
+            }
+        };
+
+        std::unique_ptr<State> _state;
+
+        WalkStream(std::unique_ptr<State>&& state)
+            : _state{ std::move(state) } {}
+
+        public:
+        class Iterator {
+            WalkStream* _stream;
+            std::optional<StreamEntry> _entry{};
+
+            public:
+            // clang-format off
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = StreamEntry;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const StreamEntry*;
+            using reference         = const StreamEntry&;
+            // clang-format on
+
+            Iterator(WalkStream* const stream)
+                : _stream{ stream } {
+                if (_stream)
+                    ++(*this);
+            }
+
+            reference operator*() const {
+                return _entry.value();
+            }
+
+            pointer operator->() const {
+                return &_entry.value();
+            }
+
+            Iterator& operator++() {
+                _entry = _stream->Next();
+                if (!_entry.has_value())
+                    _stream = nullptr;
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const {
+                return _stream == other._stream;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return _stream != other._stream;
+            }
+        };
+
+        WalkStream(WalkStream&&) noexcept = default;
+        WalkStream& operator=(WalkStream&&) noexcept = default;
+
+        // brief: gives the next entry, parks the calling thread while walkers have not found it yet
+        // return: the entry or std::nullopt if the walk is finished (or stopped by Cancel-method)
+        std::optional<StreamEntry> Next() {
+            return _state->channel.Extract();
+        }
+
+        // brief: stops the walk, the entries which are already in the channel can be read yet
+        void Cancel() {
+            _state->channel.Close();
+        }
+
+        Iterator begin() {
+            return Iterator(this);
+        }
+
+        Iterator end() {
+            return Iterator(nullptr);
+        }
+    };
+
     RecursiveWalking(
         size_t deep = SIZE_MAX,
         size_t thread_quantity = std::max<size_t>(2 /*at least two threads will running*/, std::thread::hardware_concurrency()))
@@ -66,28 +855,226 @@ class RecursiveWalking {
             throw std::exception("quantity of parallel threads must be greater then zero");
     }
 
-    void WalkIn(const fs::path& catalog, const OptActionType& action_with_file = std::nullopt, const OptActionType& action_with_dir = std::nullopt) {
-        fs::directory_entry initial_dir{ catalog };
+    // brief: sets the placement and the priority of all threads of walks: walkers, readers and processors (see LaunchPolicy-struct)
+    // note: the policy is resolved here, so the wrong NUMA node is reported by this method
+    RecursiveWalking& SetLaunchPolicy(const LaunchPolicy& policy) {
+        _launch_policy = policy.Resolve();
+        return *this;
+    }
 
-        if (!static_cast<fs::directory_entry>(initial_dir).is_directory())
-            throw std::exception("initial directory is not OS catalog");
+    // brief: switches WalkIn-method and WalkInEntries-method to the adaptive quantity of walkers: the walk starts with min_workers walkers,
+    // | the walkers are added while the queue of catalogs grows or the scans are blocked by I/O and are retired while the frontier shrinks
+    // note: the quantity of threads of the constructor is not used by these methods then, the other methods keep the fixed quantity
+    // note: the walkers are added in the pool of threads, so it is supported only with PARALLELIZATION_BASE::THREAD_POOL
+    // param: scaling - the bounds and the triggers of the scaling, std::nullopt - back to the fixed quantity of walkers
+    RecursiveWalking& SetScaling(const std::optional<WalkScaling>& scaling) {
+        if (scaling.has_value()) {
+            if (Base != PARALLELIZATION_BASE::THREAD_POOL)
+                throw std::exception("adaptive quantity of walkers is supported only with PARALLELIZATION_BASE::THREAD_POOL");
+            if (!scaling->min_workers || scaling->min_workers > scaling->max_workers)
+                throw std::exception("quantity of walkers must be greater then zero and must not exceed its maximum");
+        }
+        _scaling = scaling;
+        return *this;
+    }
 
-        void (RecursiveWalking::*RealWalker)(WalkerCounter&, ListUnchekedDirectory&, const ActionType* const, const ActionType* const) = nullptr;
-        if (bool is_f = action_with_file.has_value(), is_d = action_with_dir.has_value(); is_f && is_d)
-            RealWalker = &RecursiveWalking::_Walker<true, true>;
-        else if (is_f && !is_d)
-            RealWalker = &RecursiveWalking::_Walker<true, false>;
-        else if (!is_f && is_d)
-            RealWalker = &RecursiveWalking::_Walker<false, true>;
-        else
+    // brief: records the spans of scans and of idle waiting of every walker in the statistics for WalkStats::WriteChromeTrace
+    // note: it is used only in instrumentation mode (see IsInstrumented-template-parameter); the spans grow with the size of the tree,
+    // | so without the trace the statistics keep only the counters of walkers
+    RecursiveWalking& SetTracing(const bool is_tracing) {
+        _is_tracing = is_tracing;
+        return *this;
+    }
+
+    // return: the statistics of walkers in instrumentation mode (see IsInstrumented-template-parameter), nothing otherwise
+    WalkResultType WalkIn(const fs::path& catalog, const OptActionType& action_with_file = std::nullopt, const OptActionType& action_with_dir = std::nullopt) {
+        return _WalkIn(catalog, action_with_file, action_with_dir, nullptr);
+    }
+
+    // brief: the same as WalkIn-method, but only the entries which satisfy the filter are given to the actions
+    // note: the filter is compiled once per walk, the excluded catalogs (see WalkFilter::exclude_directories) are never opened
+    WalkResultType WalkIn(
+        const fs::path& catalog,
+        const WalkFilter& filter,
+        const OptActionType& action_with_file = std::nullopt,
+        const OptActionType& action_with_dir = std::nullopt) {
+        return _WalkIn(catalog, action_with_file, action_with_dir, &filter);
+    }
+
+    // brief: the same as WalkIn-method, but the walk can be stopped before its end: by the stop token, by the deadline, by the budget of entries
+    // | or by the decision of the action (see WALK_DECISION), the action can also skip the sub tree of the catalog
+    // note: the stopped walk drops the catalogs of its queue and all walkers return after the entries which they process now,
+    // | so the cost of the walk is proportional to the part of the tree which is needed by the caller
+    // return: the reason of the finish and the quantity of entries which are given to the actions (the statistics of instrumentation mode are not returned)
+    WalkOutcome WalkIn(
+        const fs::path& catalog,
+        const WalkLimits& limits,
+        const OptControlledActionType& action_with_file = std::nullopt,
+        const OptControlledActionType& action_with_dir = std::nullopt) {
+        WalkControl control{ limits };
+        _WalkIn(catalog, action_with_file, action_with_dir, nullptr, &control);
+        return control.GetOutcome();
+    }
+
+    // brief: the same as WalkIn-method, but the actions get the entry of catalog instead of its full path,
+    // | so with ENUMERATION_ENGINE::LINUX_OPENAT the full path is built only when the action asks it by entry.path()
+    // note: the entry is valid only during the call of the action
+    WalkResultType WalkInEntries(
+        const fs::path& catalog,
+        const OptEntryActionType& action_with_file = std::nullopt,
+        const OptEntryActionType& action_with_dir = std::nullopt) {
+        return _WalkIn(catalog, action_with_file, action_with_dir, nullptr);
+    }
+
+    // brief: the same as WalkInEntries-method, but only the entries which satisfy the filter are given to the actions
+    WalkResultType WalkInEntries(
+        const fs::path& catalog,
+        const WalkFilter& filter,
+        const OptEntryActionType& action_with_file = std::nullopt,
+        const OptEntryActionType& action_with_dir = std::nullopt) {
+        return _WalkIn(catalog, action_with_file, action_with_dir, &filter);
+    }
+
+    // brief: the same as WalkIn-method, but the lists of entries of catalogs are taken from the index of the previous walk if the catalogs are not changed
+    // param: index_file - the file of the index of catalogs (see WalkIndex-class), it is replaced by the index of the current walk
+    // note: the actions get is_changed = false for the entries which are taken from the index (the catalog of the entry is not changed since the previous walk),
+    // | the sub catalogs of unchanged catalogs are checked anyway, because the change of an entry does not change the stamps of the catalogs above it.
+    void WalkInIncremental(
+        const fs::path& catalog,
+        const fs::path& index_file,
+        const OptIncrementalActionType& action_with_file = std::nullopt,
+        const OptIncrementalActionType& action_with_dir = std::nullopt) {
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+        const IncrementalActionType* const action_file_ptr = action_with_file.has_value() ? &action_with_file.operator*() : nullptr;
+        const IncrementalActionType* const action_dir_ptr = action_with_dir.has_value() ? &action_with_dir.operator*() : nullptr;
+
+        WalkIndexBuilder current_index{ index_file };
+        {
+            const WalkIndex previous_index{ index_file };
+            QueueIncrementalDirectory unchecked_directories{ _thread_quantity };
+            unchecked_directories.Emplace(0, 0, initial_dir.path());
+            _MakeExecutor(_thread_quantity)
+                .Launch(&RecursiveWalking::_IncrementalWalker, this, std::ref(unchecked_directories), &previous_index, &current_index, action_file_ptr, action_dir_ptr)
+                .WaitWhileAllFinished();
+        }
+        current_index.Save(index_file);
+    }
+
+    // brief: walks in the catalog and calls the actions in the deterministic order: every catalog is followed by its sub tree,
+    // | the entries of every catalog are sorted by name (as `find` with sorted entries of catalogs)
+    // param: capacity - the maximal quantity of entries which are scanned by walkers, but not given to the actions yet
+    // note: the catalogs are scanned and sorted by walkers in parallel, only the emission is sequential: the actions are called by the calling thread,
+    // | which scans the needed catalog itself if no walker has taken it yet, so the walkers which are parked by the capacity never stall the emission
+    void WalkInSorted(
+        const fs::path& catalog,
+        const OptActionType& action_with_file = std::nullopt,
+        const OptActionType& action_with_dir = std::nullopt,
+        const size_t capacity = 65536) {
+        static_assert(
+            Base == PARALLELIZATION_BASE::STD_THREAD || Base == PARALLELIZATION_BASE::THREAD_POOL,
+            "the emission needs walkers which are running at the same time as the caller");
+        if (!action_with_file.has_value() && !action_with_dir.has_value())
             throw std::exception("at least one action (with files or with directory) must be assigned");
 
-        const ActionType* const action_file_ptr = action_with_file.has_value() ? &action_with_file.operator*() : nullptr;
-        const ActionType* const action_dir_ptr = action_with_dir.has_value() ? &action_with_dir.operator*() : nullptr;
-        ListUnchekedDirectory unchecked_directories{ { 0, initial_dir } };
-        WalkerCounter walker_counter{};
-        ParallelExecutor<Base>{ _thread_quantity }
-            .Launch(RealWalker, this, std::ref(walker_counter), std::ref(unchecked_directories), action_file_ptr, action_dir_ptr)
-            .WaitWhileAllFinished<10>();
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+        EnumeratorType initial_enumerator{};
+        SortedWalkState state{ _thread_quantity, capacity };
+        const SortedNodePtr root{ std::make_shared<SortedNode>(0, initial_enumerator.ToDirectory(initial_dir)) };
+        state.nodes.Emplace(0, root);
+
+        // NOTE: the destruction of the unit waits while all walkers are finished, it happens after the release of parked walkers by the guard
+        auto walkers = _MakeExecutor(_thread_quantity).Launch(&RecursiveWalking::_SortedWalker, this, &state);
+        // NOTE: the walkers are released also if the action throws, they complete the rest of catalogs without parking then
+        struct EmissionGuard {
+            SortedWalkState& state;
+
+            ~EmissionGuard() {
+                std::lock_guard lock(state.mutex);
+                state.is_emitted = true;
+                state.drained.notify_all();
+            }
+        } emission_guard{ state };
+        _EmitSorted(
+            root, state, action_with_file.has_value() ? &action_with_file.operator*() : nullptr, action_with_dir.has_value() ? &action_with_dir.operator*() : nullptr);
+    }
+
+    // brief: starts the walk in the catalog in background and returns the stream of its entries (files and catalogs)
+    // param: capacity - the maximal quantity of entries which are found by walkers, but not read by the caller yet
+    // note: the entries are given in order of their finding, which is not deterministic
+    WalkStream WalkInStream(const fs::path& catalog, const size_t capacity = 4096) {
+        static_assert(
+            Base == PARALLELIZATION_BASE::STD_THREAD || Base == PARALLELIZATION_BASE::THREAD_POOL,
+            "the stream needs walkers which are running at the same time as the caller");
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+        return WalkStream(std::make_unique<typename WalkStream::State>(*this, initial_dir, capacity));
+    }
+
+    // brief: walks in the catalog and calls the action with the content of every file by the pipeline of three stages:
+    // | the walkers find the files, the readers read them and the processors call the action, every stage has own threads;
+    // | so the waiting of the disk for the contents of files does not stall the scan of catalogs
+    // param: action - the action of processors, the view of the content is valid only during the call of the action
+    // param: options - the quantities of threads of readers and processors, the capacities of queues between stages and the way of reading
+    // note: the stages are connected by the bounded queues, so the fast stage is parked while the next one is busy and the memory is limited
+    void WalkInContent(const fs::path& catalog, const ContentActionType& action, const ContentPipelineOptions& options = {}) {
+        static_assert(
+            Base == PARALLELIZATION_BASE::STD_THREAD || Base == PARALLELIZATION_BASE::THREAD_POOL,
+            "the stages of the pipeline need threads which are running at the same time");
+        if (!options.readers_quantity || !options.processors_quantity)
+            throw std::exception("quantity of threads of every stage must be greater then zero");
+
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+        FoundFilesChannel found_files{ options.paths_capacity };
+        ReadFilesChannel read_files{ options.contents_capacity };
+        std::atomic_size_t unfinished_readers{ options.readers_quantity };
+
+        // NOTE: the stages are started from the last one, so the consumers of every queue are running before its producers
+        auto processors = _MakeExecutor(options.processors_quantity).Launch(&RecursiveWalking::_ContentProcessor, &read_files, &action);
+        auto readers = _MakeExecutor(options.readers_quantity).Launch(
+            &RecursiveWalking::_ContentReader, &found_files, &read_files, options.reading, &unfinished_readers);
+        _Launch(initial_dir, &RecursiveWalking::_ContentWalker, &found_files);
+        readers.WaitWhileAllFinished();
+        processors.WaitWhileAllFinished();
+    }
+
+#ifdef __linux__
+    // brief: walks in the catalog like WalkIn-method and keeps watching it by inotify, the changes are given to the actions by DirectoryWatcher::Process
+    // note: the actions of the initial walk get WATCH_EVENT::EXISTING and are called by walkers before the returning of the watcher
+    DirectoryWatcher<RecursiveWalking> WatchIn(
+        const fs::path& catalog,
+        const typename DirectoryWatcher<RecursiveWalking>::OptActionType& action_with_file = std::nullopt,
+        const typename DirectoryWatcher<RecursiveWalking>::OptActionType& action_with_dir = std::nullopt) {
+        return DirectoryWatcher<RecursiveWalking>(catalog, _deep, _thread_quantity, action_with_file, action_with_dir);
+    }
+
+    // brief: walks in the catalog and calls the action once per scanned catalog with all its entries (files and sub catalogs)
+    // t-param: IsWithMetadata - to collect the mode, the links, the size, the blocks and the modification time of entries by statx during the scan
+    // note: the view of entries is valid only during the call of the action
+    template<bool IsWithMetadata = false>
+    void WalkInBatches(const fs::path& catalog, const BatchActionType& action) {
+        static_assert(Engine != ENUMERATION_ENGINE::STD_FILESYSTEM, "batches of entries are implemented only for Linux enumeration engines");
+        _Launch(_GetInitialDirectory(catalog), &RecursiveWalking::_BatchWalker<IsWithMetadata>, &action);
+    }
+
+    // brief: walks in the catalog and sums the sizes and the blocks of entries into the totals of every catalog (like du-utility),
+    // | the totals of every subtree are added to its parent by the walker which finishes it, so there is no pass over the tree after the walk
+    // note: the catalogs deeper than the limit of deep are walked too, but they are not stored in the tree, their totals are summed into their ancestor at the limit
+    // note: the file with several hard links is counted once (by the first of its links which is met by walkers),
+    // | the symbolic links are counted by own size and are not followed
+    DiskUsageTree WalkInUsage(const fs::path& catalog) {
+        static_assert(Engine != ENUMERATION_ENGINE::STD_FILESYSTEM, "the disk usage is implemented only for Linux enumeration engines");
+        const fs::directory_entry initial_dir{ _GetInitialDirectory(catalog) };
+
+        EntryInfo root_info{};
+        root_info.FillMetadata(AT_FDCWD, catalog.c_str());
+        auto root = std::make_unique<DiskUsageNode>(nullptr, std::string_view{});
+        root->Add(DiskUsageTotals{ root_info.size, root_info.blocks, 0, 1 });
+
+        EnumeratorType initial_enumerator{};
+        InodeSet inodes{};
+        QueueUsageDirectory usage_directories{ _thread_quantity };
+        usage_directories.Emplace(0, 0, initial_enumerator.ToDirectory(initial_dir), root.get());
+        _MakeExecutor(_thread_quantity).Launch(&RecursiveWalking::_UsageWalker, this, std::ref(usage_directories), &inodes).WaitWhileAllFinished();
+        return DiskUsageTree(catalog, std::move(root));
     }
+#endif
 };
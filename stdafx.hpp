@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <mutex>
 #include <future>
 #include <memory>
@@ -11,5 +12,10 @@
 #include <filesystem>
 #include <functional>
 #include <shared_mutex>
+#include <unordered_map>
+#include <condition_variable>
 
 namespace fs = std::filesystem;
+
+// NOTE: size of the CPU cache line, used to separate data which is written by different threads
+inline constexpr size_t CACHE_LINE_SIZE{ 64 };
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "thread_pool.hpp"
+
+// brief: graph of tasks where every task is started in the pool of threads as soon as all tasks which it depends on are finished,
+// | so the independent branches of the graph do not wait for each other on a common barrier
+// note: the graph is built before its start (see Run-method), the tasks can not be added to the started graph
+// note: the results of tasks are kept by the handles of tasks (see TaskHandle-class), so the handles can be used after the destruction of the graph
+class TaskGraph {
+#pragma region inner types and aliases
+    struct Task {
+        // NOTE: the action gets the index of the copy (see AddParallel-method)
+        std::function<void(size_t /*copy_index*/)> action{};
+        // NOTE: it is called by the last finished copy before the start of continuations
+        std::function<void()> finalize{};
+        size_t copies_quantity{ 1 };
+        std::atomic_size_t unfinished_copies{};
+        std::atomic_size_t unfinished_dependencies{};
+        std::vector<Task*> continuations{};
+    };
+
+    // NOTE: the result of the task without result is only the flag of its finish
+    template<class ResultType>
+    using StoredType = std::conditional_t<std::is_void_v<ResultType>, bool, ResultType>;
+#pragma endregion inner types and aliases
+
+    public:
+    // brief: the handle of the task of the graph which is used to set dependencies and to get the result of the task
+    // t-param: ResultType - data-type of the result of the task (std::vector of results of copies for the task of AddParallel-method)
+    template<class ResultType>
+    class TaskHandle {
+        friend class TaskGraph;
+
+        Task* _task;
+        std::shared_ptr<std::optional<StoredType<ResultType>>> _result;
+
+        TaskHandle(Task* const task)
+            : _task{ task }
+            , _result{ std::make_shared<std::optional<StoredType<ResultType>>>() } {}
+
+        public:
+        // note: the result can be taken only after the finish of the graph (see TaskGraph::Wait) or by the tasks which depend on this task
+        const StoredType<ResultType>& GetResult() const {
+            static_assert(!std::is_void_v<ResultType>, "the task has no result");
+            if (!_result->has_value())
+                throw std::exception("the task is not finished");
+            return _result->value();
+        }
+    };
+
+    private:
+    std::shared_ptr<ThreadPool> _thread_pool;
+    // NOTE: the deque does not move its elements while new ones are added, so the tasks can refer to each other
+    std::deque<Task> _tasks{};
+    std::atomic_size_t _unfinished_tasks{};
+    std::mutex _finish_mutex{};
+    std::condition_variable _finished{};
+    bool _is_started{ false };
+
+    Task& _AddTask(std::initializer_list<Task*> dependencies) {
+        if (_is_started)
+            throw std::exception("task can not be added to the started graph");
+
+        Task& task = _tasks.emplace_back();
+        task.unfinished_dependencies = dependencies.size();
+        for (Task* const dependency : dependencies)
+            dependency->continuations.push_back(&task);
+        return task;
+    }
+
+    void _Submit(Task& task) {
+        task.unfinished_copies = task.copies_quantity;
+        for (size_t copy{ 0 }; copy < task.copies_quantity; ++copy)
+            _thread_pool->Submit([this, &task, copy]() {
+                task.action(copy);
+                _CompleteCopy(task);
+            });
+    }
+
+    void _CompleteCopy(Task& task) {
+        if (--task.unfinished_copies)
+            return;
+
+        if (task.finalize)
+            task.finalize();
+        for (Task* const continuation : task.continuations)
+            if (--continuation->unfinished_dependencies == 0)
+                _Submit(*continuation);
+
+        if (--_unfinished_tasks == 0) {
+            std::lock_guard lock(_finish_mutex);
+            _finished.notify_all();
+        }
+    }
+
+    template<class ResultType, class FunctionType>
+    static void _StoreResult(std::optional<StoredType<ResultType>>& result, FunctionType&& function) {
+        if constexpr (std::is_void_v<ResultType>) {
+            function();
+            result.emplace(true);
+        } else {
+            result.emplace(function());
+        }
+    }
+
+    public:
+#pragma region constructors / destructor
+    // note: thread_pool - the pool of threads for tasks, if it is not set the shared pool is used (see ThreadPool::Shared)
+    TaskGraph(std::shared_ptr<ThreadPool> thread_pool = nullptr)
+        : _thread_pool{ thread_pool ? std::move(thread_pool) : ThreadPool::Shared() } {}
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // NOTE: the tasks refer to the graph, so it must live while they are running
+    ~TaskGraph() {
+        if (_is_started)
+            Wait();
+    }
+#pragma endregion constructors / destructor
+
+    // brief: adds the task which is started after the finish of all dependencies
+    // param: function - the callable object without parameters, its result is the result of the task
+    template<class FunctionType, class... DependencyTypes>
+    auto Add(FunctionType&& function, const TaskHandle<DependencyTypes>&... dependencies) {
+        using ResultType = std::invoke_result_t<FunctionType>;
+        TaskHandle<ResultType> handle{ &_AddTask({ dependencies._task... }) };
+        handle._task->action = [function = std::forward<FunctionType>(function), result = handle._result](size_t) mutable {
+            _StoreResult<ResultType>(*result, function);
+        };
+        return handle;
+    }
+
+    // brief: adds the task which is started after the finish of the dependency and gets its result
+    // param: function - the callable object which gets the constant reference to the result of the dependency (or nothing if the dependency has no result)
+    template<class DependencyResultType, class FunctionType>
+    auto Then(const TaskHandle<DependencyResultType>& dependency, FunctionType&& function) {
+        if constexpr (std::is_void_v<DependencyResultType>) {
+            return Add(std::forward<FunctionType>(function), dependency);
+        } else {
+            return Add(
+                [function = std::forward<FunctionType>(function), dependency_result = dependency._result]() mutable {
+                    return function(std::as_const(dependency_result->value()));
+                },
+                dependency);
+        }
+    }
+
+    // brief: adds the task which is running by several copies in parallel after the finish of all dependencies
+    // param: function - the callable object which gets the index of the copy
+    // note: the result of the task is std::vector of results of all copies in order of their indices, so it can be aggregated by Then-method
+    template<class FunctionType, class... DependencyTypes>
+    auto AddParallel(const size_t copies_quantity, FunctionType&& function, const TaskHandle<DependencyTypes>&... dependencies) {
+        if (!copies_quantity)
+            throw std::exception("quantity of copies must be greater then zero");
+
+        using CopyResultType = std::invoke_result_t<FunctionType, size_t>;
+        using ResultType = std::conditional_t<std::is_void_v<CopyResultType>, void, std::vector<StoredType<CopyResultType>>>;
+        TaskHandle<ResultType> handle{ &_AddTask({ dependencies._task... }) };
+        Task& task = *handle._task;
+        task.copies_quantity = copies_quantity;
+
+        if constexpr (std::is_void_v<CopyResultType>) {
+            task.action = std::forward<FunctionType>(function);
+            task.finalize = [result = handle._result]() { result->emplace(true); };
+        } else {
+            // NOTE: every copy writes only own result, the results are gathered by the last finished copy
+            auto copies_results = std::make_shared<std::vector<std::optional<CopyResultType>>>(copies_quantity);
+            task.action = [function = std::forward<FunctionType>(function), copies_results](const size_t copy) mutable {
+                (*copies_results)[copy].emplace(function(copy));
+            };
+            task.finalize = [copies_results, result = handle._result]() {
+                ResultType results{};
+                results.reserve(copies_results->size());
+                for (std::optional<CopyResultType>& copy_result : *copies_results)
+                    results.emplace_back(std::move(copy_result.value()));
+                result->emplace(std::move(results));
+            };
+        }
+        return handle;
+    }
+
+    // brief: starts the tasks without dependencies, the rest of tasks are started by the finish of their dependencies
+    void Run() {
+        if (_is_started)
+            throw std::exception("graph is already started");
+
+        _is_started = true;
+        _unfinished_tasks = _tasks.size();
+        if (_tasks.empty())
+            return;
+
+        // NOTE: the roots are collected before the start, because the started tasks change the counters of dependencies;
+        // | the dependencies of a task are always added before it, so the graph has no cycles and has at least one root
+        std::vector<Task*> roots{};
+        for (Task& task : _tasks)
+            if (!task.unfinished_dependencies)
+                roots.push_back(&task);
+        for (Task* const root : roots)
+            _Submit(*root);
+    }
+
+    // brief: parks the calling thread until all tasks of the graph are finished
+    void Wait() {
+        std::unique_lock lock(_finish_mutex);
+        _finished.wait(lock, [this]() { return !_unfinished_tasks; });
+    }
+};
@@ -0,0 +1,158 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: runs every combination of the type of walk, the parallelization base, the enumeration engine and the quantity of threads
+// | on the reproducible synthetic trees and writes the results as JSON lines
+// note: the benchmark is configured by the environment variables:
+// | BENCH_TREES - the names of trees separated by comma (default: wide,deep,skewed,empty,million);
+// | BENCH_THREADS - the quantities of threads separated by comma (default: 1,2,4,8,16);
+// | BENCH_REPEATS - quantity of walks of every combination (default: 5);
+// | BENCH_COLD - 1 to measure also with cold page cache (needs the rights of administrator, default: 0);
+// | BENCH_KEEP_TREES - 1 to keep generated trees for the next run (default: 0);
+// | BENCH_OUTPUT - the file of results (default: benchmark_results.jsonl).
+class Benchmark : public testing::Test {
+    struct Tree {
+        const char* name;
+        std::function<void(const fs::path&)> generator;
+    };
+
+    static std::optional<fs::path> _trees_directory;
+    static std::optional<std::ofstream> _output;
+
+    public:
+    static std::string GetEnvironment(const char* name, const char* default_value) {
+        const char* value = std::getenv(name);
+        return value && *value ? value : default_value;
+    }
+
+    static std::vector<std::string> Split(const std::string& values) {
+        std::vector<std::string> result{};
+        std::stringstream stream(values);
+        for (std::string value; std::getline(stream, value, ',');)
+            if (!value.empty())
+                result.emplace_back(value);
+        return result;
+    }
+
+    static const std::vector<Tree>& GetTrees() {
+        // clang-format off
+        static const std::vector<Tree> trees{
+            // NOTE: 1000 catalogs * 100 files = 100k files
+            { "wide",    [](const fs::path& dir) { SuitCommon::CreateCatalogsTree(dir, 1 /*deep*/, 1000 /*catalogs*/, 100 /*files*/); } },
+            // NOTE: 512 catalogs in chain * 50 files = 25.6k files
+            { "deep",    [](const fs::path& dir) { SuitCommon::CreateCatalogsChain(dir, 511 /*deep*/, 50 /*files*/); } },
+            { "skewed",  [](const fs::path& dir) { std::mt19937 random(42); SuitCommon::CreateSkewedCatalogsTree(dir, 8 /*deep*/, random); } },
+            // NOTE: 11110 catalogs without files
+            { "empty",   [](const fs::path& dir) { SuitCommon::CreateCatalogsTree(dir, 4 /*deep*/, 10 /*catalogs*/, 0 /*files*/); } },
+            // NOTE: 11110 catalogs and 11111 * 90 = 999990 files
+            { "million", [](const fs::path& dir) { SuitCommon::CreateCatalogsTree(dir, 4 /*deep*/, 10 /*catalogs*/, 90 /*files*/); } },
+        };
+        // clang-format on
+        return trees;
+    }
+
+    static void SetUpTestSuite() {
+        _trees_directory = fs::current_path().append("benchmark_trees");
+        fs::create_directory(_trees_directory.value());
+        _output.emplace(GetEnvironment("BENCH_OUTPUT", "benchmark_results.jsonl"), std::ios_base::app);
+    }
+
+    static void TearDownTestSuite() {
+        _output.reset();
+        if (_trees_directory.has_value() && GetEnvironment("BENCH_KEEP_TREES", "0") != "1")
+            fs::remove_all(_trees_directory.value());
+    }
+
+    // brief: generates the tree once, the marker of complete generation allows to reuse the tree by the next run
+    static fs::path PrepareTree(const Tree& tree) {
+        const fs::path dir = fs::path(_trees_directory.value()).append(tree.name);
+        const fs::path marker = fs::path(_trees_directory.value()).append(std::string(tree.name) + ".complete");
+        if (!fs::exists(marker)) {
+            fs::remove_all(dir);
+            fs::create_directory(dir);
+            tree.generator(dir);
+            std::ofstream(marker).close();
+        }
+        return dir;
+    }
+
+    // brief: returns the value of the percentile by nearest-rank method
+    static double GetPercentile(std::vector<double> values, const double percentile) {
+        std::sort(values.begin(), values.end());
+        const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * values.size()));
+        return values[rank ? rank - 1 : 0];
+    }
+
+    template<WALK_TYPE Type, PARALLELIZATION_BASE Base, ENUMERATION_ENGINE Engine>
+    static void Run(const char* tree_name, const fs::path& dir, const char* walk_name, const char* base_name, const char* engine_name) {
+        const size_t repeats = std::max<size_t>(1, std::stoull(GetEnvironment("BENCH_REPEATS", "5")));
+        const bool is_cold_enabled = GetEnvironment("BENCH_COLD", "0") == "1";
+
+        for (const std::string& threads : Split(GetEnvironment("BENCH_THREADS", "1,2,4,8,16"))) {
+            RecursiveWalking<Type, Base, Engine> walker(SIZE_MAX, std::stoull(threads));
+            for (const bool is_cold : { false, true }) {
+                if (is_cold && !is_cold_enabled)
+                    continue;
+
+                std::atomic_size_t entries{};
+                auto action = [&](size_t, const fs::path&) { ++entries; };
+                // NOTE: the warm walk is preceded by the walk which fills the page cache
+                if (!is_cold)
+                    walker.WalkIn(dir, action, action);
+
+                SuitCommon::ResetPeakMemory();
+                std::vector<double> times{};
+                for (size_t i{ 0 }; i < repeats; ++i) {
+                    if (is_cold && !SuitCommon::DropPageCache()) {
+                        std::cout << "page cache can not be dropped, cold measurement is skipped" << std::endl;
+                        return;
+                    }
+                    entries = 0;
+                    times.emplace_back(SuitCommon::Measure([&]() { walker.WalkIn(dir, action, action); }));
+                }
+
+                const double p50 = GetPercentile(times, 50), p99 = GetPercentile(times, 99);
+                std::stringstream line{};
+                line << "{\"tree\":\"" << tree_name << "\",\"entries\":" << entries << ",\"walk_type\":\"" << walk_name << "\",\"base\":\"" << base_name
+                     << "\",\"engine\":\"" << engine_name << "\",\"threads\":" << threads << ",\"cache\":\"" << (is_cold ? "cold" : "warm")
+                     << "\",\"repeats\":" << repeats << ",\"entries_per_sec\":" << static_cast<size_t>(entries / p50) << ",\"p50_ms\":" << p50 * 1e3
+                     << ",\"p99_ms\":" << p99 * 1e3 << ",\"peak_rss_kb\":" << SuitCommon::GetPeakMemory() << "}";
+                std::cout << line.str() << std::endl;
+                *_output << line.str() << std::endl;
+            }
+        }
+    }
+
+    template<WALK_TYPE Type, PARALLELIZATION_BASE Base>
+    static void RunEngines(const char* tree_name, const fs::path& dir, const char* walk_name, const char* base_name) {
+        Run<Type, Base, ENUMERATION_ENGINE::STD_FILESYSTEM>(tree_name, dir, walk_name, base_name, "STD_FILESYSTEM");
+#ifdef __linux__
+        Run<Type, Base, ENUMERATION_ENGINE::LINUX_GETDENTS>(tree_name, dir, walk_name, base_name, "LINUX_GETDENTS");
+        Run<Type, Base, ENUMERATION_ENGINE::LINUX_OPENAT>(tree_name, dir, walk_name, base_name, "LINUX_OPENAT");
+        Run<Type, Base, ENUMERATION_ENGINE::LINUX_IO_URING>(tree_name, dir, walk_name, base_name, "LINUX_IO_URING");
+#endif
+    }
+
+    template<WALK_TYPE Type>
+    static void RunBases(const char* tree_name, const fs::path& dir, const char* walk_name) {
+        RunEngines<Type, PARALLELIZATION_BASE::STD_THREAD>(tree_name, dir, walk_name, "STD_THREAD");
+        RunEngines<Type, PARALLELIZATION_BASE::STD_FUTURE>(tree_name, dir, walk_name, "STD_FUTURE");
+        RunEngines<Type, PARALLELIZATION_BASE::STL_ALGORITHMS>(tree_name, dir, walk_name, "STL_ALGORITHMS");
+        RunEngines<Type, PARALLELIZATION_BASE::THREAD_POOL>(tree_name, dir, walk_name, "THREAD_POOL");
+    }
+};
+
+std::optional<fs::path> Benchmark::_trees_directory{};
+std::optional<std::ofstream> Benchmark::_output{};
+
+TEST_F(Benchmark, AllCombinations) {
+    for (const std::string& tree_name : Split(GetEnvironment("BENCH_TREES", "wide,deep,skewed,empty,million"))) {
+        auto tree = std::find_if(GetTrees().begin(), GetTrees().end(), [&](const auto& tree) { return tree_name == tree.name; });
+        ASSERT_NE(tree, GetTrees().end()) << "unknown tree: " << tree_name;
+
+        const fs::path dir = PrepareTree(*tree);
+        RunBases<WALK_TYPE::LENGTH>(tree->name, dir, "LENGTH");
+        RunBases<WALK_TYPE::WIDTH>(tree->name, dir, "WIDTH");
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "stdafx.hpp"
+
+#include <random>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <ctime>
+#include <unistd.h>
+#endif
+
+// brief: helpers which are shared by all suit tests (benchmarks)
+struct SuitCommon {
+    /**
+    * brief: creates reproducible catalogs-tree-structure
+    * param: dir - the root catalog of the tree (must exist)
+    * param: deep - the depth of a last sub catalog from the root catalog
+    * param: catalogs - quantity of sub catalogs for all catalogs in tree
+    * param: files - quantity of files for all catalogs in tree
+    */
+    static void CreateCatalogsTree(const fs::path& dir, size_t deep, size_t catalogs, size_t files) {
+        if (deep > 0) {
+            for (size_t i = 1; i <= catalogs; i++) {
+                fs::path sub_dir = fs::path(dir).append(std::string("sub_dir_").append(std::to_string(i)));
+                fs::create_directory(sub_dir);
+                CreateCatalogsTree(sub_dir, deep - 1, catalogs, files);
+            }
+        }
+
+        for (size_t i = 1; i <= files; ++i)
+            std::fstream(fs::path(dir).append(std::string("file_").append(std::to_string(i))).string(), std::ios_base::app).close();
+    }
+
+    /**
+    * brief: creates reproducible catalogs-tree-structure with skewed distribution of work:
+    * | about 10% of catalogs have many sub catalogs and the rest of them have one, the quantity of files is random
+    * param: dir - the root catalog of the tree (must exist)
+    * param: deep - the depth of a last sub catalog from the root catalog
+    * param: random - the generator of the tree, the same seed gives the same tree
+    */
+    static void CreateSkewedCatalogsTree(const fs::path& dir, size_t deep, std::mt19937& random) {
+        const size_t files = random() % 50;
+        const size_t catalogs = deep == 0 ? 0 : (random() % 10 == 0 ? 20 : 1);
+        for (size_t i = 1; i <= catalogs; ++i) {
+            fs::path sub_dir = fs::path(dir).append(std::string("sub_dir_").append(std::to_string(i)));
+            fs::create_directory(sub_dir);
+            CreateSkewedCatalogsTree(sub_dir, deep - 1, random);
+        }
+
+        for (size_t i = 1; i <= files; ++i)
+            std::fstream(fs::path(dir).append(std::string("file_").append(std::to_string(i))).string(), std::ios_base::app).close();
+    }
+
+    /**
+    * brief: creates the chain of catalogs where every catalog has one sub catalog
+    * param: dir - the root catalog of the chain (must exist)
+    * param: deep - the length of the chain
+    * param: files - quantity of files for all catalogs in chain
+    */
+    static void CreateCatalogsChain(const fs::path& dir, size_t deep, size_t files) {
+        fs::path current_dir = dir;
+        for (size_t level = 0; level <= deep; ++level) {
+            for (size_t i = 1; i <= files; ++i)
+                std::fstream(fs::path(current_dir).append(std::string("file_").append(std::to_string(i))).string(), std::ios_base::app).close();
+            if (level < deep) {
+                current_dir.append("d");
+                fs::create_directory(current_dir);
+            }
+        }
+    }
+
+    // brief: returns quantity of seconds spent on the call of the action
+    template<class ActionType>
+    static double Measure(ActionType&& action) {
+        const auto start = std::chrono::steady_clock::now();
+        action();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // brief: returns quantity of seconds of CPU time (user + system) spent by all threads of the process
+    static double GetProcessCpuTime() {
+#ifdef _WIN32
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time);
+        auto to_seconds = [](const FILETIME& ft) { return static_cast<double>(static_cast<uint64_t>(ft.dwHighDateTime) << 32 | ft.dwLowDateTime) * 1e-7; };
+        return to_seconds(kernel_time) + to_seconds(user_time);
+#else
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    // brief: returns the peak of resident memory of the process in KB since the last call of ResetPeakMemory-method
+    // note: on Windows the peak can not be reset, so it is the peak since the start of the process
+    static size_t GetPeakMemory() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);)
+            if (line.rfind("VmHWM:", 0) == 0)
+                return std::stoull(line.substr(6));
+        return 0;
+#endif
+    }
+
+    static void ResetPeakMemory() {
+#ifndef _WIN32
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+
+    // brief: drops the page cache of OS (needs the rights of administrator)
+    // return: false if the page cache can not be dropped
+    static bool DropPageCache() {
+#ifdef _WIN32
+        return false;
+#else
+        ::sync();
+        std::ofstream drop_caches("/proc/sys/vm/drop_caches");
+        drop_caches << "3";
+        drop_caches.flush();
+        return static_cast<bool>(drop_caches);
+#endif
+    }
+};
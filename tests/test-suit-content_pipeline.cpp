@@ -0,0 +1,90 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the reading of files by the action of walkers with the content pipeline (see RecursiveWalking::WalkInContent)
+// note: the files are read with cold page cache if it can be dropped (needs the rights of administrator), otherwise with warm one
+class ContentPipeline : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+    static constexpr size_t FILE_SIZE{ 128 * 1024 };
+
+    // NOTE: 8 * 8 catalogs with 40 files = 2560 files (320 MB)
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_content_pipeline");
+        fs::create_directory(_test_directory.value());
+        const std::string content(FILE_SIZE, 'x');
+        for (size_t i{ 0 }; i < 8; ++i)
+            for (size_t j{ 0 }; j < 8; ++j) {
+                const fs::path dir = fs::path(_test_directory.value()).append("dir_" + std::to_string(i)).append("dir_" + std::to_string(j));
+                fs::create_directories(dir);
+                for (size_t k{ 0 }; k < 40; ++k)
+                    std::ofstream(fs::path(dir).append("file_" + std::to_string(k)), std::ios_base::binary) << content;
+            }
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    // NOTE: the processing of the content is the checksum of all its bytes
+    static uint64_t Process(const std::string_view content) {
+        uint64_t checksum{};
+        for (const char symbol : content)
+            checksum = checksum * 31 + static_cast<unsigned char>(symbol);
+        return checksum;
+    }
+
+    template<class ActionType>
+    static void PrintThroughput(const char* name, ActionType&& walk) {
+        const bool is_cold = SuitCommon::DropPageCache();
+        const double time = SuitCommon::Measure(walk);
+        std::cout << name << (is_cold ? " (cold cache)" : " (warm cache)") << " | MB/sec: " << static_cast<size_t>(320 / time) << std::endl;
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> ContentPipeline::_test_directory{};
+
+TEST_F(ContentPipeline, Throughput) {
+    RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL> walker(SIZE_MAX, THREADS_QUANTITY);
+
+    std::atomic_size_t files{};
+    PrintThroughput("reading by walkers", [&]() {
+        walker.WalkIn(GetTestDirectory(), [&](size_t, const fs::path& path) {
+            // NOTE: the same reading as the readers of the pipeline do, but on the walker thread
+            if (const std::optional<FileContent> content{ FileContent::Read(path, CONTENT_READING::PREAD) }) {
+                Process(content->View());
+                ++files;
+            }
+        });
+    });
+    ASSERT_EQ(static_cast<size_t>(files), size_t{ 2560 });
+
+    for (const size_t readers_quantity : { 2, 4, 8 })
+        for (const CONTENT_READING reading : { CONTENT_READING::MMAP, CONTENT_READING::PREAD }) {
+            ContentPipelineOptions options{};
+            options.readers_quantity = readers_quantity;
+            options.processors_quantity = THREADS_QUANTITY;
+            options.reading = reading;
+            files = 0;
+            const std::string name{ std::string("pipeline, readers: ") + std::to_string(readers_quantity) +
+                                    (reading == CONTENT_READING::MMAP ? ", mmap" : ", pread") };
+            PrintThroughput(name.c_str(), [&]() {
+                walker.WalkInContent(
+                    GetTestDirectory(),
+                    [&](size_t, const fs::path&, std::string_view content) {
+                        Process(content);
+                        ++files;
+                    },
+                    options);
+            });
+            ASSERT_EQ(static_cast<size_t>(files), size_t{ 2560 });
+        }
+}
@@ -0,0 +1,80 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+#include <set>
+
+// brief: compares the disk usage by the actions of walkers, which sum the metadata into the locked map of catalogs and then sum the catalogs
+// | into their parents by the serial pass, with RecursiveWalking::WalkInUsage, which sums the subtrees into their parents during the walk
+class DiskUsageSuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_disk_usage_suit");
+        fs::create_directory(_test_directory.value());
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 10 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> DiskUsageSuit::_test_directory{};
+
+TEST_F(DiskUsageSuit, Throughput) {
+    std::mutex usage_mutex;
+    std::unordered_map<std::string, DiskUsageTotals> usage{};
+    std::set<std::pair<uint64_t, uint64_t>> identities{};
+    const double map_time = SuitCommon::Measure([&]() {
+        auto add = [&](const fs::path& path, const bool is_directory) {
+            struct stat entry_stat;
+            if (::lstat(path.c_str(), &entry_stat) != 0)
+                return;
+            const DiskUsageTotals totals{
+                static_cast<uint64_t>(entry_stat.st_size), static_cast<uint64_t>(entry_stat.st_blocks), is_directory ? 0u : 1u, is_directory ? 1u : 0u
+            };
+            std::lock_guard locker(usage_mutex);
+            if (!is_directory && entry_stat.st_nlink > 1 && !identities.emplace(entry_stat.st_dev, entry_stat.st_ino).second)
+                return;
+            usage[is_directory ? path.native() : path.parent_path().native()] += totals;
+        };
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(SIZE_MAX, THREADS_QUANTITY)
+            .WalkIn(GetTestDirectory(), [&](size_t, const fs::path& path) { add(path, false); }, [&](size_t, const fs::path& path) { add(path, true); });
+        add(GetTestDirectory(), true);
+
+        // NOTE: the serial pass from the deepest catalogs to the root
+        std::vector<std::string> catalogs{};
+        catalogs.reserve(usage.size());
+        for (const auto& [catalog, totals] : usage)
+            catalogs.push_back(catalog);
+        std::sort(catalogs.begin(), catalogs.end(), [](const std::string& left, const std::string& right) { return left.size() > right.size(); });
+        for (const std::string& catalog : catalogs)
+            if (catalog != GetTestDirectory().native())
+                usage[fs::path(catalog).parent_path().native()] += usage[catalog];
+    });
+
+    std::optional<DiskUsageTree> tree{};
+    const double usage_time = SuitCommon::Measure([&]() {
+        tree.emplace(RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(SIZE_MAX, THREADS_QUANTITY)
+                         .WalkInUsage(GetTestDirectory()));
+    });
+
+    const DiskUsageTotals& total = tree->GetRoot().totals;
+    std::cout << "actions + locked map + serial pass | catalogs: " << usage.size() << " | ms: " << map_time * 1e3 << std::endl;
+    std::cout << "WalkInUsage | catalogs: " << tree->size() << " | ms: " << usage_time * 1e3 << std::endl;
+    std::cout << "total | files: " << total.files << " | catalogs: " << total.directories << " | bytes: " << total.size
+              << " | disk bytes: " << total.GetDiskBytes() << std::endl;
+    ASSERT_EQ(tree->size(), usage.size());
+    ASSERT_EQ(total, usage[GetTestDirectory().native()]);
+}
+#endif
@@ -0,0 +1,76 @@
+#include "tests/test-suit-common.hpp"
+
+#include "duplicate_finder.hpp"
+
+#ifdef __linux__
+// brief: compares DuplicateFinder-class with the search which hashes the whole content of every file by the action of walkers
+// note: the files are read with cold page cache if it can be dropped (needs the rights of administrator), otherwise with warm one
+class DuplicateFinderSuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+    static constexpr size_t FILES_QUANTITY{ 2000 };
+    static constexpr size_t DUPLICATES_QUANTITY{ 100 };
+
+    // NOTE: the files of random sizes from 64 KB to 512 KB, every 20th file is the copy of the previous one
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_duplicates_suit");
+        std::mt19937 random{ 17 };
+        std::string content{};
+        for (size_t i{ 0 }; i < FILES_QUANTITY; ++i) {
+            const fs::path dir = fs::path(_test_directory.value()).append("dir_" + std::to_string(i % 40));
+            fs::create_directories(dir);
+            if (i % (FILES_QUANTITY / DUPLICATES_QUANTITY) != 1) {
+                content.resize(64 * 1024 + random() % (448 * 1024));
+                for (char& symbol : content)
+                    symbol = static_cast<char>(random());
+            }
+            std::ofstream(fs::path(dir).append("file_" + std::to_string(i)), std::ios_base::binary) << content;
+        }
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> DuplicateFinderSuit::_test_directory{};
+
+TEST_F(DuplicateFinderSuit, Throughput) {
+    std::mutex hashes_mutex;
+    std::unordered_map<uint64_t, size_t> hashes{};
+    std::atomic<uint64_t> naive_read_bytes{};
+    const bool is_cold = SuitCommon::DropPageCache();
+    const double naive_time = SuitCommon::Measure([&]() {
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL>(SIZE_MAX, THREADS_QUANTITY).WalkIn(GetTestDirectory(), [&](size_t, const fs::path& path) {
+            if (const std::optional<FileContent> content{ FileContent::Read(path) }) {
+                naive_read_bytes += content->size();
+                const uint64_t hash = XxHash64::Hash(content->View());
+                std::lock_guard locker(hashes_mutex);
+                ++hashes[hash];
+            }
+        });
+    });
+    size_t naive_groups{};
+    for (const auto& [hash, quantity] : hashes)
+        naive_groups += quantity > 1;
+
+    DuplicateReport report{};
+    SuitCommon::DropPageCache();
+    const double finder_time = SuitCommon::Measure([&]() { report = DuplicateFinder<>(THREADS_QUANTITY).Find(GetTestDirectory()); });
+
+    const char* cache{ is_cold ? " (cold cache)" : " (warm cache)" };
+    std::cout << "hashing of all files" << cache << " | groups: " << naive_groups << " | read MB: " << naive_read_bytes / (1024 * 1024)
+              << " | sec: " << naive_time << std::endl;
+    std::cout << "DuplicateFinder" << cache << " | groups: " << report.groups.size() << " | read MB: " << report.read_bytes / (1024 * 1024)
+              << " | sec: " << finder_time << " | files: " << report.files << " -> by size: " << report.size_candidates
+              << " -> by sample: " << report.sample_candidates << std::endl;
+    ASSERT_EQ(report.groups.size(), naive_groups);
+}
+#endif
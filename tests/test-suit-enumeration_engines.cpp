@@ -0,0 +1,140 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the throughput of the walk with different enumeration engines on the tree of 1M+ entries
+class EnumerationEngines : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_engines");
+        fs::create_directory(_test_directory.value());
+        // NOTE: 11110 catalogs and 11111 * 90 = 999990 files
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 90 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    template<ENUMERATION_ENGINE Engine>
+    void PrintThroughput(const char* engine_name) {
+        std::atomic_size_t entries{};
+        auto action = [&](size_t, const fs::path&) { ++entries; };
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine> walker(SIZE_MAX, THREADS_QUANTITY);
+
+        // NOTE: the first walk warms the page cache up
+        walker.WalkIn(_test_directory.value(), action, action);
+        entries = 0;
+        const double time = SuitCommon::Measure([&]() { walker.WalkIn(_test_directory.value(), action, action); });
+        std::cout << engine_name << " | entries: " << entries << " | entries/sec: " << static_cast<size_t>(static_cast<double>(entries) / time)
+                  << std::endl;
+    }
+
+    // brief: the same as PrintThroughput-method, but the action does not ask full paths of entries
+    template<ENUMERATION_ENGINE Engine>
+    void PrintThroughputWithoutPaths(const char* engine_name) {
+        std::atomic_size_t entries{};
+        auto action = [&](size_t, const auto&) { ++entries; };
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine> walker(SIZE_MAX, THREADS_QUANTITY);
+
+        walker.WalkInEntries(_test_directory.value(), action, action);
+        entries = 0;
+        const double time = SuitCommon::Measure([&]() { walker.WalkInEntries(_test_directory.value(), action, action); });
+        std::cout << engine_name << " (without paths) | entries: " << entries
+                  << " | entries/sec: " << static_cast<size_t>(static_cast<double>(entries) / time) << std::endl;
+    }
+
+#ifdef __linux__
+    // brief: the same as PrintThroughputWithoutPaths-method, but the action is called once per catalog with all its entries
+    template<ENUMERATION_ENGINE Engine, bool IsWithMetadata>
+    void PrintThroughputByBatches(const char* engine_name) {
+        std::atomic_size_t entries{}, bytes{};
+        auto action = [&](size_t, const fs::path&, const EntriesView& batch) {
+            entries += batch.size;
+            if constexpr (IsWithMetadata) {
+                size_t batch_bytes{};
+                for (const EntryInfo& entry : batch)
+                    batch_bytes += entry.size;
+                bytes += batch_bytes;
+            }
+        };
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine> walker(SIZE_MAX, THREADS_QUANTITY);
+
+        walker.template WalkInBatches<IsWithMetadata>(_test_directory.value(), action);
+        entries = 0;
+        const double time = SuitCommon::Measure([&]() { walker.template WalkInBatches<IsWithMetadata>(_test_directory.value(), action); });
+        std::cout << engine_name << (IsWithMetadata ? " (batches with statx)" : " (batches)") << " | entries: " << entries
+                  << " | entries/sec: " << static_cast<size_t>(static_cast<double>(entries) / time) << std::endl;
+    }
+
+    // brief: the same as PrintThroughputByBatches-method with metadata, but the page cache is dropped before the walk,
+    // | so the walkers wait for the disk and the engines which keep several operations in flight get the advantage
+    // return: false if the page cache can not be dropped (needs the rights of administrator)
+    template<ENUMERATION_ENGINE Engine>
+    bool PrintColdThroughputByBatches(const char* engine_name, const size_t threads_quantity) {
+        std::atomic_size_t entries{};
+        auto action = [&](size_t, const fs::path&, const EntriesView& batch) { entries += batch.size; };
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine> walker(SIZE_MAX, threads_quantity);
+
+        if (!SuitCommon::DropPageCache())
+            return false;
+        const double time = SuitCommon::Measure([&]() { walker.template WalkInBatches<true>(_test_directory.value(), action); });
+        std::cout << engine_name << " (cold batches with statx) | threads: " << threads_quantity << " | entries: " << entries
+                  << " | entries/sec: " << static_cast<size_t>(static_cast<double>(entries) / time) << std::endl;
+        return true;
+    }
+#endif
+};
+
+std::optional<fs::path> EnumerationEngines::_test_directory{};
+
+TEST_F(EnumerationEngines, Throughput) {
+    PrintThroughput<ENUMERATION_ENGINE::STD_FILESYSTEM>("STD_FILESYSTEM");
+#ifdef __linux__
+    PrintThroughput<ENUMERATION_ENGINE::LINUX_GETDENTS>("LINUX_GETDENTS");
+    PrintThroughput<ENUMERATION_ENGINE::LINUX_OPENAT>("LINUX_OPENAT");
+    PrintThroughput<ENUMERATION_ENGINE::LINUX_IO_URING>("LINUX_IO_URING");
+#endif
+}
+
+TEST_F(EnumerationEngines, ThroughputWithoutPaths) {
+    PrintThroughputWithoutPaths<ENUMERATION_ENGINE::STD_FILESYSTEM>("STD_FILESYSTEM");
+#ifdef __linux__
+    PrintThroughputWithoutPaths<ENUMERATION_ENGINE::LINUX_GETDENTS>("LINUX_GETDENTS");
+    PrintThroughputWithoutPaths<ENUMERATION_ENGINE::LINUX_OPENAT>("LINUX_OPENAT");
+    PrintThroughputWithoutPaths<ENUMERATION_ENGINE::LINUX_IO_URING>("LINUX_IO_URING");
+#endif
+}
+
+#ifdef __linux__
+TEST_F(EnumerationEngines, ThroughputByBatches) {
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_GETDENTS, false>("LINUX_GETDENTS");
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_OPENAT, false>("LINUX_OPENAT");
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_IO_URING, false>("LINUX_IO_URING");
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_GETDENTS, true>("LINUX_GETDENTS");
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_OPENAT, true>("LINUX_OPENAT");
+    PrintThroughputByBatches<ENUMERATION_ENGINE::LINUX_IO_URING, true>("LINUX_IO_URING");
+}
+#endif
+
+#ifdef __linux__
+TEST_F(EnumerationEngines, ThroughputColdCache) {
+    for (const size_t threads_quantity : { size_t{ 2 }, THREADS_QUANTITY }) {
+        if (!PrintColdThroughputByBatches<ENUMERATION_ENGINE::LINUX_OPENAT>("LINUX_OPENAT", threads_quantity))
+            GTEST_SKIP() << "the page cache can not be dropped";
+        for (const unsigned queue_depth : { 16u, 64u, 256u }) {
+            using EnumeratorType = DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_IO_URING>;
+            const unsigned default_queue_depth{ EnumeratorType::GetQueueDepth() };
+            EnumeratorType::SetQueueDepth(queue_depth);
+            std::cout << "queue depth: " << queue_depth << " | ";
+            PrintColdThroughputByBatches<ENUMERATION_ENGINE::LINUX_IO_URING>("LINUX_IO_URING", threads_quantity);
+            EnumeratorType::SetQueueDepth(default_queue_depth);
+        }
+    }
+}
+#endif
@@ -0,0 +1,60 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: measures wall time and CPU time of walks where most of the walkers have nothing to do
+class IdleCpuTime : public testing::Test {
+    static std::optional<fs::path> _narrow_directory;
+    static std::optional<fs::path> _small_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _narrow_directory = fs::current_path().append("test_directory_narrow");
+        fs::create_directory(_narrow_directory.value());
+        SuitCommon::CreateCatalogsTree(_narrow_directory.value(), 64 /*deep*/, 1 /*catalogs*/, 200 /*files*/);
+
+        _small_directory = fs::current_path().append("test_directory_small");
+        fs::create_directory(_small_directory.value());
+        SuitCommon::CreateCatalogsTree(_small_directory.value(), 1 /*deep*/, 5 /*catalogs*/, 5 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        for (const std::optional<fs::path>& dir : { _narrow_directory, _small_directory })
+            if (dir.has_value())
+                fs::remove_all(dir.value());
+    }
+
+    template<class ActionType>
+    static void PrintTimes(const char* name, ActionType&& action) {
+        const double cpu_start = SuitCommon::GetProcessCpuTime();
+        const double wall_time = SuitCommon::Measure(std::forward<ActionType>(action));
+        const double cpu_time = SuitCommon::GetProcessCpuTime() - cpu_start;
+        std::cout << name << " | wall, ms: " << wall_time * 1e3 << " | cpu, ms: " << cpu_time * 1e3 << std::endl;
+    }
+
+    static void NarrowWalk() {
+        std::atomic_size_t counter{};
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::STD_THREAD>(SIZE_MAX, THREADS_QUANTITY)
+            .WalkIn(_narrow_directory.value(), [&](size_t, const fs::path&) { ++counter; });
+    }
+
+    static void SmallWalks() {
+        std::atomic_size_t counter{};
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD> walker(SIZE_MAX, THREADS_QUANTITY);
+        for (size_t i{ 0 }; i < 100; ++i)
+            walker.WalkIn(_small_directory.value(), [&](size_t, const fs::path&) { ++counter; });
+    }
+};
+
+std::optional<fs::path> IdleCpuTime::_narrow_directory{};
+std::optional<fs::path> IdleCpuTime::_small_directory{};
+
+TEST_F(IdleCpuTime, NarrowTree) {
+    PrintTimes("narrow tree, 1 walk", &IdleCpuTime::NarrowWalk);
+}
+
+TEST_F(IdleCpuTime, SmallTree) {
+    PrintTimes("small tree, 100 walks", &IdleCpuTime::SmallWalks);
+}
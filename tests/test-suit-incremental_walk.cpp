@@ -0,0 +1,66 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the full walk and the incremental walk of the mostly static tree
+class IncrementalWalk : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+    static std::optional<fs::path> _index_file;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_incremental");
+        _index_file = fs::current_path().append("test_directory_incremental.index");
+        fs::create_directory(_test_directory.value());
+        // NOTE: 11110 catalogs and 11111 * 20 = 222220 files
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 20 /*files*/);
+        // NOTE: the catalogs changed at the same tick of the file system clock as the walk is started are not trusted by the index
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+        if (_index_file.has_value())
+            fs::remove(_index_file.value());
+    }
+
+    template<ENUMERATION_ENGINE Engine>
+    static void PrintTimes(const char* engine_name) {
+        fs::remove(_index_file.value());
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine> walker(SIZE_MAX, THREADS_QUANTITY);
+
+        std::atomic_size_t entries{}, changed_entries{};
+        auto action = [&](size_t, const fs::path&) { ++entries; };
+        auto incremental_action = [&](size_t, const fs::path&, bool is_changed) {
+            ++entries;
+            if (is_changed)
+                ++changed_entries;
+        };
+
+        walker.WalkIn(_test_directory.value(), action, action);
+        entries = 0;
+        const double full_time = SuitCommon::Measure([&]() { walker.WalkIn(_test_directory.value(), action, action); });
+        std::cout << engine_name << " | full walk | entries: " << entries << " | ms: " << full_time * 1e3 << std::endl;
+
+        for (const char* name : { "incremental walk without index", "incremental walk with index" }) {
+            entries = changed_entries = 0;
+            const double time = SuitCommon::Measure([&]() { walker.WalkInIncremental(_test_directory.value(), _index_file.value(), incremental_action, incremental_action); });
+            std::cout << engine_name << " | " << name << " | entries: " << entries << " | changed: " << changed_entries << " | ms: " << time * 1e3
+                      << std::endl;
+        }
+        std::cout << engine_name << " | size of index, bytes: " << fs::file_size(_index_file.value()) << std::endl;
+    }
+};
+
+std::optional<fs::path> IncrementalWalk::_test_directory{};
+std::optional<fs::path> IncrementalWalk::_index_file{};
+
+TEST_F(IncrementalWalk, UnchangedTree) {
+    PrintTimes<ENUMERATION_ENGINE::STD_FILESYSTEM>("STD_FILESYSTEM");
+#ifdef __linux__
+    PrintTimes<ENUMERATION_ENGINE::LINUX_GETDENTS>("LINUX_GETDENTS");
+#endif
+}
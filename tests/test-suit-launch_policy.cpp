@@ -0,0 +1,120 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+// brief: measures the effect of LaunchPolicy-struct on the walk and on the neighbour work of the process
+// note: the layout of two sockets is emulated by two halves of the CPUs of the cpuset of the process
+// | (with one CPU both emulated sockets are this CPU)
+class LaunchPolicySuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_launch_policy");
+        fs::create_directory(_test_directory.value());
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 8 /*catalogs*/, 10 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    // brief: splits the CPUs of the process to two emulated sockets
+    static std::pair<std::vector<size_t>, std::vector<size_t>> GetEmulatedSockets() {
+        cpu_set_t process_cpus;
+        ::sched_getaffinity(0, sizeof(process_cpus), &process_cpus);
+        std::vector<size_t> cpus{};
+        for (size_t cpu{ 0 }; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &process_cpus))
+                cpus.push_back(cpu);
+        const size_t middle{ std::max<size_t>(1, cpus.size() / 2) };
+        return { std::vector<size_t>(cpus.begin(), cpus.begin() + middle), std::vector<size_t>(cpus.end() - std::min(middle, cpus.size()), cpus.end()) };
+    }
+
+    // return: entries per second of the best of three walks
+    static size_t MeasureWalk(const LaunchPolicy& policy) {
+        std::atomic_size_t entries{};
+        double best_time{ std::numeric_limits<double>::max() };
+        for (size_t attempt{ 0 }; attempt < 3; ++attempt) {
+            entries = 0;
+            auto action = [&](size_t, const fs::path&) { ++entries; };
+            RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD, ENUMERATION_ENGINE::LINUX_OPENAT> walking(SIZE_MAX, THREADS_QUANTITY);
+            walking.SetLaunchPolicy(policy);
+            best_time = std::min(best_time, SuitCommon::Measure([&]() { walking.WalkIn(_test_directory.value(), action, action); }));
+        }
+        return static_cast<size_t>(static_cast<double>(entries) / best_time);
+    }
+
+    // brief: measures the time of the fixed CPU work of the foreground thread on the first CPU of the socket while the walks run in background
+    // return: seconds of the foreground work
+    static double MeasureForeground(const std::vector<size_t>& socket, const LaunchPolicy& background_policy) {
+        std::atomic_bool is_finished{ false };
+        std::thread background([&]() {
+            while (!is_finished) {
+                RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD, ENUMERATION_ENGINE::LINUX_OPENAT> walking(SIZE_MAX, THREADS_QUANTITY);
+                walking.SetLaunchPolicy(background_policy).WalkIn(_test_directory.value(), [](size_t, const fs::path&) {});
+            }
+        });
+
+        LaunchPolicy foreground_policy{};
+        foreground_policy.cpus = { socket.front() };
+        const LaunchPolicy::ThreadScope foreground_scope{ foreground_policy.Resolve(), 0 };
+        volatile uint64_t accumulator{};
+        const double result = SuitCommon::Measure([&]() {
+            for (uint64_t i{ 0 }; i < 200'000'000; ++i)
+                accumulator = accumulator + i;
+        });
+        is_finished = true;
+        background.join();
+        return result;
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> LaunchPolicySuit::_test_directory{};
+
+TEST_F(LaunchPolicySuit, Placement) {
+    const auto [first_socket, second_socket] = GetEmulatedSockets();
+    LaunchPolicy one_socket{};
+    one_socket.cpus = first_socket;
+    LaunchPolicy spread{};
+    spread.cpus = first_socket;
+    spread.cpus.insert(spread.cpus.end(), second_socket.begin(), second_socket.end());
+    spread.pinning = PINNING::SPREAD;
+
+    std::cout << "emulated sockets | CPUs: " << first_socket.size() << " + " << second_socket.size() << std::endl;
+    std::cout << "policy | entries/sec" << std::endl;
+    std::cout << "default | " << MeasureWalk(LaunchPolicy{}) << std::endl;
+    std::cout << "one socket (SET) | " << MeasureWalk(one_socket) << std::endl;
+    std::cout << "both sockets (SPREAD) | " << MeasureWalk(spread) << std::endl;
+}
+
+TEST_F(LaunchPolicySuit, BackgroundScheduling) {
+    const auto [first_socket, second_socket] = GetEmulatedSockets();
+    LaunchPolicy normal{};
+    normal.cpus = first_socket;
+    LaunchPolicy idle{ normal };
+    idle.scheduling = SCHEDULING_CLASS::IDLE;
+    LaunchPolicy other_socket{};
+    other_socket.cpus = second_socket;
+    other_socket.scheduling = SCHEDULING_CLASS::IDLE;
+
+    const double alone = SuitCommon::Measure([&]() {
+        volatile uint64_t accumulator{};
+        for (uint64_t i{ 0 }; i < 200'000'000; ++i)
+            accumulator = accumulator + i;
+    });
+    std::cout << "background walks | sec of foreground work" << std::endl;
+    std::cout << "none | " << alone << std::endl;
+    std::cout << "same socket, NORMAL | " << MeasureForeground(first_socket, normal) << std::endl;
+    std::cout << "same socket, IDLE | " << MeasureForeground(first_socket, idle) << std::endl;
+    std::cout << "other socket, IDLE | " << MeasureForeground(first_socket, other_socket) << std::endl;
+}
+#endif
@@ -0,0 +1,55 @@
+#include "tests/test-suit-common.hpp"
+
+#include "thread_safe_container.hpp"
+#include "lock_free_ring.hpp"
+
+// brief: compares the throughput of LockFreeRing-class and ThreadSafeList-class under contention of producers and consumers
+class LockFreeRingContention : public testing::Test {
+    public:
+    static constexpr size_t ELEMENTS_QUANTITY{ 1 << 20 };
+    static constexpr size_t RING_CAPACITY{ 1024 };
+
+    // brief: every producer adds its part of elements and every consumer extracts elements while all of them are not extracted
+    // return: quantity of operations (adding and extracting) per second
+    template<class ContainerType>
+    static double MeasureThroughput(ContainerType& container, const size_t threads_quantity) {
+        std::atomic_size_t consumed{};
+        const double time = SuitCommon::Measure([&]() {
+            std::vector<std::thread> threads{};
+            for (size_t producer{ 0 }; producer < threads_quantity; ++producer)
+                threads.emplace_back([&, producer]() {
+                    for (size_t i{ producer }; i < ELEMENTS_QUANTITY; i += threads_quantity)
+                        if constexpr (std::is_same_v<ContainerType, LockFreeRing<size_t>>) {
+                            while (!container.emplace_back(i))
+                                std::this_thread::yield();
+                        } else {
+                            container.emplace_back(i);
+                        }
+                });
+            for (size_t consumer{ 0 }; consumer < threads_quantity; ++consumer)
+                threads.emplace_back([&]() {
+                    while (consumed < ELEMENTS_QUANTITY)
+                        if (container.ExtractFront().has_value())
+                            ++consumed;
+                        else
+                            std::this_thread::yield();
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+        });
+        return 2 * ELEMENTS_QUANTITY / time;
+    }
+};
+
+TEST_F(LockFreeRingContention, ThroughputByThreads) {
+    for (const size_t threads_quantity : { 1, 2, 4, 8, 16, 32, 64 }) {
+        ThreadSafeList<size_t> list{};
+        const double list_throughput = MeasureThroughput(list, threads_quantity);
+        LockFreeRing<size_t> ring(RING_CAPACITY);
+        const double ring_throughput = MeasureThroughput(ring, threads_quantity);
+        std::cout << "producers / consumers: " << threads_quantity << " | ThreadSafeList, Mops/s: " << list_throughput / 1e6
+                  << " | LockFreeRing, Mops/s: " << ring_throughput / 1e6 << std::endl;
+        ASSERT_TRUE(list.ExtractFront() == std::nullopt);
+        ASSERT_TRUE(ring.empty());
+    }
+}
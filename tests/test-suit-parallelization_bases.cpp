@@ -0,0 +1,62 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the cost of launching short-lived parallelization units by different parallelization bases
+class ParallelizationBases : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+    static constexpr size_t LAUNCHES_QUANTITY{ 1000 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_bases");
+        fs::create_directory(_test_directory.value());
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 1 /*deep*/, 5 /*catalogs*/, 5 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    template<PARALLELIZATION_BASE Base>
+    void PrintLaunchCost(const char* base_name) {
+        std::atomic_size_t counter{};
+        ParallelExecutor<Base> pe(THREADS_QUANTITY);
+        const double total_time = SuitCommon::Measure([&]() {
+            for (size_t i{ 0 }; i < LAUNCHES_QUANTITY; ++i)
+                pe.Launch([&]() { ++counter; }).WaitWhileAllFinished();
+        });
+        ASSERT_EQ(static_cast<size_t>(counter), THREADS_QUANTITY * LAUNCHES_QUANTITY);
+        std::cout << base_name << " | launch+wait, us: " << total_time * 1e6 / LAUNCHES_QUANTITY << std::endl;
+    }
+
+    template<PARALLELIZATION_BASE Base>
+    void PrintSmallWalkCost(const char* base_name) {
+        std::atomic_size_t counter{};
+        RecursiveWalking<WALK_TYPE::WIDTH, Base> walker(SIZE_MAX, THREADS_QUANTITY);
+        const double total_time = SuitCommon::Measure([&]() {
+            for (size_t i{ 0 }; i < LAUNCHES_QUANTITY; ++i)
+                walker.WalkIn(_test_directory.value(), [&](size_t, const fs::path&) { ++counter; });
+        });
+        std::cout << base_name << " | small WalkIn, us: " << total_time * 1e6 / LAUNCHES_QUANTITY << std::endl;
+    }
+};
+
+std::optional<fs::path> ParallelizationBases::_test_directory{};
+
+TEST_F(ParallelizationBases, LaunchCost) {
+    PrintLaunchCost<PARALLELIZATION_BASE::STD_THREAD>("STD_THREAD");
+    PrintLaunchCost<PARALLELIZATION_BASE::STD_FUTURE>("STD_FUTURE");
+    PrintLaunchCost<PARALLELIZATION_BASE::STL_ALGORITHMS>("STL_ALGORITHMS");
+    PrintLaunchCost<PARALLELIZATION_BASE::THREAD_POOL>("THREAD_POOL");
+}
+
+TEST_F(ParallelizationBases, SmallWalkCost) {
+    PrintSmallWalkCost<PARALLELIZATION_BASE::STD_THREAD>("STD_THREAD");
+    PrintSmallWalkCost<PARALLELIZATION_BASE::STD_FUTURE>("STD_FUTURE");
+    PrintSmallWalkCost<PARALLELIZATION_BASE::STL_ALGORITHMS>("STL_ALGORITHMS");
+    PrintSmallWalkCost<PARALLELIZATION_BASE::THREAD_POOL>("THREAD_POOL");
+}
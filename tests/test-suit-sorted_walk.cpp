@@ -0,0 +1,64 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+// brief: compares the sorted output by the collection of entries of the unordered walk and their sorting on one thread
+// | with RecursiveWalking::WalkInSorted, which sorts every catalog in walkers and emits the entries while the walk goes on
+class SortedWalkSuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_sorted_walk");
+        fs::create_directory(_test_directory.value());
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 10 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> SortedWalkSuit::_test_directory{};
+
+TEST_F(SortedWalkSuit, Throughput) {
+    using Walking = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>;
+    std::mutex paths_mutex;
+    std::vector<fs::path> collected{};
+    // NOTE: the comparison of fs::path is element-wise, so it gives the same order as WalkInSorted-method
+    const double collect_time = SuitCommon::Measure([&]() {
+        auto collect = [&](size_t, const fs::path& path) {
+            std::lock_guard locker(paths_mutex);
+            collected.push_back(path);
+        };
+        Walking(SIZE_MAX, THREADS_QUANTITY).WalkIn(GetTestDirectory(), collect, collect);
+        std::sort(collected.begin(), collected.end());
+    });
+
+    std::vector<fs::path> emitted{};
+    emitted.reserve(collected.size());
+    double first_entry_time{};
+    const auto start = std::chrono::steady_clock::now();
+    const double sorted_time = SuitCommon::Measure([&]() {
+        auto emit = [&](size_t, const fs::path& path) {
+            if (emitted.empty())
+                first_entry_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            emitted.push_back(path);
+        };
+        Walking(SIZE_MAX, THREADS_QUANTITY).WalkInSorted(GetTestDirectory(), emit, emit);
+    });
+
+    std::cout << "unordered walk + sort | entries: " << collected.size() << " | ms: " << collect_time * 1e3 << " | first entry ms: " << collect_time * 1e3
+              << std::endl;
+    std::cout << "WalkInSorted | entries: " << emitted.size() << " | ms: " << sorted_time * 1e3 << " | first entry ms: " << first_entry_time * 1e3 << std::endl;
+    ASSERT_EQ(emitted, collected);
+}
+#endif
@@ -0,0 +1,85 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the search of the first match by the full walk with the walk which is stopped by the action (see WALK_DECISION),
+// | and measures how promptly the walk is finished by the deadline and by the stop token
+class WalkControlSuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_walk_control");
+        fs::create_directory(_test_directory.value());
+        // NOTE: 11111 catalogs with 10 files, the needle is in the second catalog of the first level
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 10 /*files*/);
+        std::ofstream(fs::path(_test_directory.value()).append("sub_dir_2").append("needle"));
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> WalkControlSuit::_test_directory{};
+
+TEST_F(WalkControlSuit, FindFirst) {
+    RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT> walking(SIZE_MAX, THREADS_QUANTITY);
+    std::atomic_size_t entries{};
+    std::atomic_bool is_found{ false };
+    const double full_time = SuitCommon::Measure([&]() {
+        walking.WalkIn(GetTestDirectory(), [&](size_t, const fs::path& path) {
+            ++entries;
+            if (path.filename() == "needle")
+                is_found = true;
+        });
+    });
+
+    WalkOutcome outcome{};
+    const double stopped_time = SuitCommon::Measure([&]() {
+        outcome = walking.WalkIn(GetTestDirectory(), WalkLimits{}, [&](size_t, const fs::path& path) {
+            return path.filename() == "needle" ? WALK_DECISION::STOP : WALK_DECISION::CONTINUE;
+        });
+    });
+
+    std::cout << "full walk | entries: " << entries << " | ms: " << full_time * 1e3 << std::endl;
+    std::cout << "stopped by action | entries: " << outcome.entries << " | ms: " << stopped_time * 1e3 << std::endl;
+    ASSERT_TRUE(is_found);
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::STOPPED_BY_ACTION);
+}
+
+TEST_F(WalkControlSuit, DeadlineAndCancel) {
+    RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT> walking(SIZE_MAX, THREADS_QUANTITY);
+    // NOTE: the slow action makes the full walk much longer than the limits
+    auto slow_action = [](size_t, const fs::path&) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        return WALK_DECISION::CONTINUE;
+    };
+
+    WalkLimits deadline{};
+    WalkOutcome outcome{};
+    const double deadline_time = SuitCommon::Measure([&]() {
+        deadline.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+        outcome = walking.WalkIn(GetTestDirectory(), deadline, slow_action);
+    });
+    std::cout << "deadline 20 ms | entries: " << outcome.entries << " | ms: " << deadline_time * 1e3 << std::endl;
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::DEADLINE);
+
+    WalkLimits cancel{};
+    cancel.stop_token.emplace();
+    std::thread canceller([token = cancel.stop_token.value()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        token.RequestStop();
+    });
+    const double cancel_time = SuitCommon::Measure([&]() { outcome = walking.WalkIn(GetTestDirectory(), cancel, slow_action); });
+    canceller.join();
+    std::cout << "stop token after 20 ms | entries: " << outcome.entries << " | ms: " << cancel_time * 1e3 << std::endl;
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::CANCELLED);
+}
@@ -0,0 +1,55 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the filtering of entries in the action of walkers with the filter which is evaluated by walkers (see WalkFilter-struct)
+// note: the most of entries of the tree are in the catalog which is excluded, as "node_modules" of a project
+class WalkFilterSuit : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_walk_filter");
+        fs::create_directories(fs::path(_test_directory.value()).append("node_modules"));
+        fs::create_directories(fs::path(_test_directory.value()).append("src"));
+        // NOTE: 1111 catalogs with 50 files in the excluded catalog and 111 catalogs with 10 files in the sources
+        SuitCommon::CreateCatalogsTree(fs::path(_test_directory.value()).append("node_modules"), 3 /*deep*/, 10 /*catalogs*/, 50 /*files*/);
+        SuitCommon::CreateCatalogsTree(fs::path(_test_directory.value()).append("src"), 2 /*deep*/, 10 /*catalogs*/, 10 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static const fs::path& GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> WalkFilterSuit::_test_directory{};
+
+TEST_F(WalkFilterSuit, Pruning) {
+    RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL> walker(SIZE_MAX, THREADS_QUANTITY);
+    std::atomic_size_t files{};
+
+    const double action_time = SuitCommon::Measure([&]() {
+        walker.WalkIn(GetTestDirectory(), [&](size_t, const fs::path& path) {
+            if (path.native().find("node_modules") == fs::path::string_type::npos && path.filename().native().rfind("file_1", 0) == 0)
+                ++files;
+        });
+    });
+    const size_t action_files{ files };
+
+    WalkFilter filter{};
+    filter.names = { "file_1*" };
+    filter.exclude_directories = { "node_modules" };
+    files = 0;
+    const double filter_time = SuitCommon::Measure([&]() { walker.WalkIn(GetTestDirectory(), filter, [&](size_t, const fs::path&) { ++files; }); });
+
+    std::cout << "filtering by action | files: " << action_files << " | ms: " << action_time * 1e3 << std::endl;
+    std::cout << "WalkFilter | files: " << files << " | ms: " << filter_time * 1e3 << std::endl;
+    ASSERT_EQ(static_cast<size_t>(files), action_files);
+}
@@ -0,0 +1,59 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: compares the latency of the first entry and the total time of the walk by the stream and by the push-walk
+class WalkStreamLatency : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_stream");
+        fs::create_directory(_test_directory.value());
+        // NOTE: 1110 catalogs and 1111 * 90 = 99990 files
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 3 /*deep*/, 10 /*catalogs*/, 90 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static fs::path GetTestDirectory() {
+        return _test_directory.value();
+    }
+};
+
+std::optional<fs::path> WalkStreamLatency::_test_directory{};
+
+TEST_F(WalkStreamLatency, FirstEntryAndTotalTime) {
+    using Walking = RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL>;
+    Walking walker(SIZE_MAX, THREADS_QUANTITY);
+
+    size_t push_entries{};
+    std::mutex push_mutex;
+    const double push_time = SuitCommon::Measure([&]() {
+        auto action = [&](size_t, const fs::path&) {
+            std::lock_guard lock(push_mutex);
+            ++push_entries;
+        };
+        walker.WalkIn(GetTestDirectory(), action, action);
+    });
+    std::cout << "WalkIn | entries: " << push_entries << " | total, ms: " << push_time * 1e3 << std::endl;
+
+    for (const size_t capacity : { 1, 64, 4096 }) {
+        size_t stream_entries{};
+        double first_entry_time{};
+        const auto start = std::chrono::steady_clock::now();
+        const double stream_time = SuitCommon::Measure([&]() {
+            for (const StreamEntry& entry : walker.WalkInStream(GetTestDirectory(), capacity))
+                if (++stream_entries == 1)
+                    first_entry_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        });
+        std::cout << "WalkInStream (capacity " << capacity << ") | entries: " << stream_entries << " | first entry, ms: " << first_entry_time * 1e3
+                  << " | total, ms: " << stream_time * 1e3 << std::endl;
+        ASSERT_EQ(stream_entries, push_entries);
+    }
+}
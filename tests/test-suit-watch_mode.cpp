@@ -0,0 +1,84 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+// brief: compares the polling by full walks with the watching of the tree by inotify
+class WatchMode : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static constexpr size_t THREADS_QUANTITY{ 8 };
+    using Walking = RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_GETDENTS>;
+
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_watch");
+        fs::create_directory(_test_directory.value());
+        // NOTE: 1110 catalogs and 1111 * 90 = 99990 files
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 3 /*deep*/, 10 /*catalogs*/, 90 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    static fs::path GetTestDirectory() {
+        return _test_directory.value();
+    }
+
+    // brief: creates the files in different catalogs of the tree
+    static void CreateFiles(const char* prefix, const size_t quantity) {
+        for (size_t i{ 0 }; i < quantity; ++i) {
+            const fs::path dir = GetTestDirectory() / ("sub_dir_" + std::to_string(i % 10 + 1)) / ("sub_dir_" + std::to_string(i / 10 % 10 + 1));
+            std::ofstream(dir / (prefix + std::to_string(i))).close();
+        }
+    }
+
+    // brief: processes the events while the quantity of events is less then expected
+    template<class WatcherType>
+    static size_t ProcessEvents(WatcherType& watcher, const size_t expected_events) {
+        size_t events{};
+        while (events < expected_events)
+            if (const size_t batch = watcher.Process(std::chrono::milliseconds(1000)); batch)
+                events += batch;
+            else
+                break;
+        return events;
+    }
+};
+
+std::optional<fs::path> WatchMode::_test_directory{};
+
+TEST_F(WatchMode, PollingVersusWatching) {
+    std::atomic_size_t entries{};
+    auto action = [&](size_t, const fs::path&) { ++entries; };
+    Walking walker(SIZE_MAX, THREADS_QUANTITY);
+    const double walk_time = SuitCommon::Measure([&]() { walker.WalkIn(GetTestDirectory(), action, action); });
+    std::cout << "full walk (polling) | entries: " << entries << " | ms: " << walk_time * 1e3 << std::endl;
+
+    std::atomic_size_t events{};
+    auto watch_action = [&](size_t, const fs::path&, WATCH_EVENT) { ++events; };
+    std::optional<double> initial_time{};
+    const double watch_time = SuitCommon::Measure([&]() {
+        auto watcher = walker.WatchIn(GetTestDirectory(), watch_action, watch_action);
+        std::cout << "initial walk of watcher | entries: " << events << " | watched catalogs: " << watcher.GetWatchedDirectoriesQuantity() << std::endl;
+
+        for (const size_t changes : { 100, 1000 }) {
+            events = 0;
+            CreateFiles(changes == 100 ? "small_" : "large_", changes);
+            const double process_time = SuitCommon::Measure([&]() { ProcessEvents(watcher, changes); });
+            std::cout << "watcher | changes: " << changes << " | events: " << events << " | ms (including latency of batch): " << process_time * 1e3 << std::endl;
+            ASSERT_EQ(events, changes);
+        }
+
+        // NOTE: the quantity of changes is greater than the default limit of the inotify queue (16384), so the queue is overflowed and the tree is rescanned
+        events = 0;
+        CreateFiles("overflow_", 20000);
+        const double overflow_time = SuitCommon::Measure([&]() { ProcessEvents(watcher, 20000); });
+        std::cout << "watcher with overflow | changes: 20000 | events: " << events << " | ms: " << overflow_time * 1e3 << std::endl;
+        ASSERT_EQ(events, size_t{ 20000 });
+    });
+    std::cout << "watcher total | ms: " << watch_time * 1e3 << std::endl;
+}
+#endif
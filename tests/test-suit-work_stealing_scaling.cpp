@@ -0,0 +1,74 @@
+#include "tests/test-suit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+// brief: measures how the throughput of RecursiveWalking-class (entries per second) changes with quantity of walker-threads
+class WorkStealingScaling : public testing::Test {
+    static std::optional<fs::path> _test_directory;
+
+    public:
+    static void SetUpTestSuite() {
+        _test_directory = fs::current_path().append("test_directory_scaling");
+        fs::create_directory(_test_directory.value());
+        SuitCommon::CreateCatalogsTree(_test_directory.value(), 4 /*deep*/, 10 /*catalogs*/, 10 /*files*/);
+    }
+
+    static void TearDownTestSuite() {
+        if (_test_directory.has_value())
+            fs::remove_all(_test_directory.value());
+    }
+
+    template<WALK_TYPE Type>
+    void PrintScaling() {
+        std::cout << "threads | entries/sec" << std::endl;
+        for (size_t threads : { 2, 4, 8, 16, 32, 64 }) {
+            std::atomic_size_t entries{};
+            double best_time{ std::numeric_limits<double>::max() };
+            for (size_t attempt{ 0 }; attempt < 3; ++attempt) {
+                entries = 0;
+                best_time = std::min(best_time, SuitCommon::Measure([&]() {
+                    auto action = [&](size_t, const fs::path&) { ++entries; };
+                    RecursiveWalking<Type, PARALLELIZATION_BASE::STD_THREAD>(SIZE_MAX, threads).WalkIn(_test_directory.value(), action, action);
+                }));
+            }
+            std::cout << threads << " | " << static_cast<size_t>(static_cast<double>(entries) / best_time) << std::endl;
+        }
+    }
+
+    // brief: compares the fixed quantities of walkers with the adaptive one (see RecursiveWalking::SetScaling) on the same tree
+    void PrintAdaptiveScaling() {
+        using InstrumentedWalking = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::STD_FILESYSTEM, true>;
+        std::cout << "walkers | peak walkers | entries/sec" << std::endl;
+        for (const std::optional<size_t> threads : { std::optional<size_t>{ 2 }, std::optional<size_t>{ 8 }, std::optional<size_t>{ 64 }, std::optional<size_t>{} }) {
+            std::atomic_size_t entries{};
+            size_t peak_workers{};
+            double best_time{ std::numeric_limits<double>::max() };
+            for (size_t attempt{ 0 }; attempt < 3; ++attempt) {
+                entries = 0;
+                best_time = std::min(best_time, SuitCommon::Measure([&]() {
+                    auto action = [&](size_t, const fs::path&) { ++entries; };
+                    InstrumentedWalking walking(SIZE_MAX, threads.value_or(1));
+                    if (!threads.has_value())
+                        walking.SetScaling(WalkScaling{});
+                    peak_workers = walking.WalkIn(_test_directory.value(), action, action).peak_workers;
+                }));
+            }
+            std::cout << (threads.has_value() ? std::to_string(threads.value()) : std::string("adaptive")) << " | " << peak_workers << " | "
+                      << static_cast<size_t>(static_cast<double>(entries) / best_time) << std::endl;
+        }
+    }
+};
+
+std::optional<fs::path> WorkStealingScaling::_test_directory{};
+
+TEST_F(WorkStealingScaling, WalkOnLenght) {
+    PrintScaling<WALK_TYPE::LENGTH>();
+}
+
+TEST_F(WorkStealingScaling, WalkOnWidth) {
+    PrintScaling<WALK_TYPE::WIDTH>();
+}
+
+TEST_F(WorkStealingScaling, Adaptive) {
+    PrintAdaptiveScaling();
+}
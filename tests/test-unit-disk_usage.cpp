@@ -0,0 +1,141 @@
+#include "tests/test-unit-common.hpp"
+
+#include "recursive_walk.hpp"
+
+#ifdef __linux__
+TEST(InodeSet_Tests, InsertOnce) {
+    InodeSet inodes{};
+    ASSERT_TRUE(inodes.Insert(1, 100));
+    ASSERT_FALSE(inodes.Insert(1, 100));
+    // NOTE: the same inode of another device is another file
+    ASSERT_TRUE(inodes.Insert(2, 100));
+    ASSERT_EQ(inodes.size(), size_t{ 2 });
+}
+
+class DiskUsageTesting : public testing::Test {
+    protected:
+    fs::path root{ fs::current_path().append("test_directory_disk_usage") };
+
+    void SetUp() override {
+        fs::remove_all(root);
+        fs::create_directories(Path("a/b/c"));
+        fs::create_directories(Path("d"));
+        Write("file_1", 100);
+        Write("a/file_2", 5000);
+        Write("a/b/file_3", 300);
+        // NOTE: the hard links of one catalog, so the totals of every catalog do not depend on the order of the walk
+        fs::create_hard_link(Path("a/b/file_3"), Path("a/b/file_3_link"));
+        Write("a/b/c/file_4", 70000);
+        Write("d/file_5", 1);
+        // NOTE: the symbolic link to the catalog is counted as a file and is not followed
+        fs::create_directory_symlink(Path("a"), Path("d/link_to_a"));
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    void Write(const fs::path& file, const size_t size) const {
+        std::ofstream(Path(file), std::ios_base::binary) << std::string(size, 'x');
+    }
+
+    fs::path Path(const fs::path& file) const {
+        return fs::path(root).append(file.native());
+    }
+
+    // brief: the reference totals of the catalog by the serial walk with lstat
+    static DiskUsageTotals ReferenceTotals(const fs::path& catalog, std::set<std::pair<uint64_t, uint64_t>>& identities) {
+        struct stat entry_stat;
+        ::lstat(catalog.c_str(), &entry_stat);
+        DiskUsageTotals result{ static_cast<uint64_t>(entry_stat.st_size), static_cast<uint64_t>(entry_stat.st_blocks), 0, 1 };
+        for (const fs::directory_entry& entry : fs::directory_iterator(catalog)) {
+            if (!entry.is_symlink() && entry.is_directory()) {
+                result += ReferenceTotals(entry.path(), identities);
+                continue;
+            }
+            ::lstat(entry.path().c_str(), &entry_stat);
+            if (entry_stat.st_nlink > 1 && !identities.emplace(entry_stat.st_dev, entry_stat.st_ino).second)
+                continue;
+            result += DiskUsageTotals{ static_cast<uint64_t>(entry_stat.st_size), static_cast<uint64_t>(entry_stat.st_blocks), 1, 0 };
+        }
+        return result;
+    }
+
+    static DiskUsageTotals ReferenceTotals(const fs::path& catalog) {
+        std::set<std::pair<uint64_t, uint64_t>> identities{};
+        return ReferenceTotals(catalog, identities);
+    }
+
+    template<PARALLELIZATION_BASE Base, ENUMERATION_ENGINE Engine>
+    void CheckUsage() {
+        const DiskUsageTree tree = RecursiveWalking<WALK_TYPE::LENGTH, Base, Engine>(SIZE_MAX, 4).WalkInUsage(root);
+
+        ASSERT_EQ(tree.size(), size_t{ 5 });
+        for (size_t index{ 0 }; index < tree.size(); ++index)
+            ASSERT_EQ(tree[index].totals, ReferenceTotals(tree.GetPath(index))) << tree.GetPath(index);
+
+        const DiskUsageTotals& total = tree.GetRoot().totals;
+        // NOTE: the hard link is counted once, the symbolic link is counted as a file
+        ASSERT_EQ(total.files, size_t{ 6 });
+        ASSERT_EQ(total.directories, size_t{ 5 });
+        ASSERT_GE(total.size, uint64_t{ 100 + 5000 + 300 + 70000 + 1 });
+    }
+};
+
+TEST_F(DiskUsageTesting, Totals_LINUX_GETDENTS) {
+    CheckUsage<PARALLELIZATION_BASE::STD_THREAD, ENUMERATION_ENGINE::LINUX_GETDENTS>();
+}
+
+TEST_F(DiskUsageTesting, Totals_LINUX_OPENAT) {
+    CheckUsage<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(DiskUsageTesting, Totals_LINUX_IO_URING) {
+    CheckUsage<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+TEST_F(DiskUsageTesting, FindAndPaths) {
+    const DiskUsageTree tree = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(SIZE_MAX, 4).WalkInUsage(root);
+
+    ASSERT_EQ(tree.Find(""), std::optional<size_t>{ 0 });
+    ASSERT_EQ(tree.Find("."), std::optional<size_t>{ 0 });
+    const std::optional<size_t> c = tree.Find("a/b/c");
+    ASSERT_TRUE(c.has_value());
+    ASSERT_EQ(tree.GetName(c.value()), "c");
+    ASSERT_EQ(tree.GetPath(c.value()), Path("a/b/c"));
+    ASSERT_EQ(tree.GetPath(tree[c.value()].parent), Path("a/b"));
+    // NOTE: the files and the symbolic links are not catalogs of the tree
+    ASSERT_FALSE(tree.Find("a/file_2").has_value());
+    ASSERT_FALSE(tree.Find("d/link_to_a").has_value());
+    ASSERT_FALSE(tree.Find("e").has_value());
+
+    // NOTE: the children are sorted by name
+    const DiskUsageTree::Node& root_node = tree.GetRoot();
+    ASSERT_EQ(root_node.children_quantity, uint32_t{ 2 });
+    ASSERT_EQ(tree.GetName(root_node.first_child), "a");
+    ASSERT_EQ(tree.GetName(root_node.first_child + 1), "d");
+}
+
+TEST_F(DiskUsageTesting, DeepLimit) {
+    // NOTE: the catalogs deeper than the first level are summed into the catalogs of the first level
+    const DiskUsageTree tree = RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(1, 4).WalkInUsage(root);
+
+    ASSERT_EQ(tree.size(), size_t{ 3 });
+    ASSERT_FALSE(tree.Find("a/b").has_value());
+    const std::optional<size_t> a = tree.Find("a");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_EQ(tree[a.value()].totals, ReferenceTotals(Path("a")));
+    ASSERT_EQ(tree.GetRoot().totals, ReferenceTotals(root));
+}
+
+TEST_F(DiskUsageTesting, HardLinksOfDifferentCatalogs) {
+    fs::create_hard_link(Path("a/b/c/file_4"), Path("d/file_4_link"));
+    fs::create_hard_link(Path("a/b/c/file_4"), Path("file_4_link"));
+
+    const DiskUsageTree tree = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(SIZE_MAX, 4).WalkInUsage(root);
+
+    // NOTE: the file is counted by one of its links, which one depends on the order of the walk, so only the total of the root is fixed
+    ASSERT_EQ(tree.GetRoot().totals, ReferenceTotals(root));
+    ASSERT_EQ(tree.GetRoot().totals.files, size_t{ 6 });
+}
+#endif
@@ -0,0 +1,87 @@
+#include "tests/test-unit-common.hpp"
+
+#include "duplicate_finder.hpp"
+
+// NOTE: the values are computed by the reference implementation of XXH64
+TEST(XxHash64_Tests, ReferenceValues) {
+    ASSERT_EQ(XxHash64::Hash(std::string_view("")), 0xEF46DB3751D8E999ULL);
+    ASSERT_EQ(XxHash64::Hash(std::string_view("abc")), 0x44BC2CF5AD770999ULL);
+    // NOTE: the input longer than the stripe of 32 bytes with the tail of every length (8, 4 and 1 bytes)
+    const std::string_view long_input{ "Nobody inspects the spammish repetition, which is longer than one stripe" };
+    ASSERT_EQ(XxHash64::Hash(long_input), XxHash64::Hash(long_input.data(), long_input.size(), 0));
+    ASSERT_NE(XxHash64::Hash(long_input), XxHash64::Hash(long_input, 1));
+}
+
+#ifdef __linux__
+class DuplicateFinderTesting : public testing::Test {
+    protected:
+    fs::path root{ fs::current_path().append("test_directory_duplicates") };
+
+    void SetUp() override {
+        fs::remove_all(root);
+        fs::create_directories(fs::path(root).append("a").append("b"));
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    void Write(const fs::path& file, const std::string& content) const {
+        std::ofstream(fs::path(root).append(file.native()), std::ios_base::binary) << content;
+    }
+
+    fs::path Path(const fs::path& file) const {
+        return fs::path(root).append(file.native());
+    }
+};
+
+TEST_F(DuplicateFinderTesting, FindsGroupsByStages) {
+    std::string large(3 * DuplicateFinder<>::SAMPLE_SIZE, 'x');
+    for (size_t i{ 0 }; i < large.size(); ++i)
+        large[i] = static_cast<char>('a' + i % 26);
+    std::string large_changed_middle{ large };
+    large_changed_middle[large.size() / 2] = '#';
+
+    Write("large_1", large);
+    Write("a/large_2", large);
+    // NOTE: the same size, head and tail, so only the hash of the whole content separates it
+    Write("a/b/large_3", large_changed_middle);
+    fs::create_hard_link(Path("large_1"), Path("a/b/large_1_link"));
+    Write("small_1", "small content");
+    Write("a/b/small_2", "small content");
+    Write("a/unique_size", "unique");
+    Write("empty_1", "");
+    Write("a/empty_2", "");
+
+    const DuplicateReport report = DuplicateFinder<>(4).Find(root);
+
+    ASSERT_EQ(report.groups.size(), size_t{ 2 });
+    ASSERT_EQ(report.groups[0].size, large.size());
+    // NOTE: the first path of the file with hard links is kept
+    std::vector<fs::path> expected_large{ Path("a/large_2"), std::min(Path("a/b/large_1_link"), Path("large_1")) };
+    std::sort(expected_large.begin(), expected_large.end());
+    ASSERT_EQ(report.groups[0].paths, expected_large);
+    ASSERT_EQ(report.groups[1].size, size_t{ 13 });
+    ASSERT_EQ(report.groups[1].paths, (std::vector<fs::path>{ Path("a/b/small_2"), Path("small_1") }));
+
+    // NOTE: the hard link is not counted, the empty files are skipped, the unique size is dropped before reading,
+    // | the changed file is dropped only after the hashing of the whole content
+    ASSERT_EQ(report.files, size_t{ 6 });
+    ASSERT_EQ(report.size_candidates, size_t{ 5 });
+    ASSERT_EQ(report.sample_candidates, size_t{ 5 });
+    ASSERT_EQ(report.read_bytes, 3 * 2 * DuplicateFinder<>::SAMPLE_SIZE + 2 * 13 + 3 * large.size());
+}
+
+TEST_F(DuplicateFinderTesting, NoDuplicates) {
+    Write("file_1", "first");
+    Write("a/file_2", "second");
+    Write("a/b/file_3", "third");
+
+    const DuplicateReport report = DuplicateFinder<PARALLELIZATION_BASE::STD_THREAD, ENUMERATION_ENGINE::LINUX_GETDENTS>(2).Find(root);
+    ASSERT_TRUE(report.groups.empty());
+    ASSERT_EQ(report.files, size_t{ 3 });
+    // NOTE: "first" and "third" have the same size, but different content
+    ASSERT_EQ(report.size_candidates, size_t{ 2 });
+    ASSERT_EQ(report.sample_candidates, size_t{ 0 });
+}
+#endif
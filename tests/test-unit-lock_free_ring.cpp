@@ -0,0 +1,89 @@
+#include "tests/test-unit-common.hpp"
+
+#include "lock_free_ring.hpp"
+#include "bounded_channel.hpp"
+
+TEST(LockFreeRing, Fifo) {
+    LockFreeRing<std::string> ring(3);
+    ASSERT_EQ(ring.capacity(), size_t{ 4 });
+    for (size_t i{ 0 }; i < ring.capacity(); ++i)
+        ASSERT_TRUE(ring.emplace_back(std::to_string(i)));
+    ASSERT_FALSE(ring.emplace_back("overflow"));
+    ASSERT_EQ(ring.size(), ring.capacity());
+
+    for (size_t i{ 0 }; i < ring.capacity(); ++i)
+        ASSERT_EQ(ring.ExtractFront(), std::to_string(i));
+    ASSERT_FALSE(ring.ExtractFront().has_value());
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(LockFreeRing, NotMovedIfFull) {
+    LockFreeRing<std::string> ring(1);
+    ASSERT_EQ(ring.capacity(), size_t{ 2 });
+    ASSERT_TRUE(ring.emplace_back("first"));
+    ASSERT_TRUE(ring.emplace_back("second"));
+    std::string element{ "third" };
+    ASSERT_FALSE(ring.push_back(std::move(element)));
+    ASSERT_EQ(element, "third");
+}
+
+TEST(LockFreeRing, MultiProducerMultiConsumer) {
+    constexpr size_t THREADS_QUANTITY{ 4 }, ELEMENTS_QUANTITY{ 100000 };
+    LockFreeRing<size_t> ring(64);
+    std::atomic_size_t consumed{}, sum{};
+
+    std::vector<std::thread> threads{};
+    for (size_t producer{ 0 }; producer < THREADS_QUANTITY; ++producer)
+        threads.emplace_back([&, producer]() {
+            for (size_t i{ producer }; i < ELEMENTS_QUANTITY; i += THREADS_QUANTITY)
+                while (!ring.emplace_back(i))
+                    std::this_thread::yield();
+        });
+    for (size_t consumer{ 0 }; consumer < THREADS_QUANTITY; ++consumer)
+        threads.emplace_back([&]() {
+            while (consumed < ELEMENTS_QUANTITY) {
+                if (std::optional<size_t> element{ ring.ExtractFront() }; element.has_value()) {
+                    sum += element.value();
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(static_cast<size_t>(consumed), ELEMENTS_QUANTITY);
+    ASSERT_EQ(static_cast<size_t>(sum), ELEMENTS_QUANTITY * (ELEMENTS_QUANTITY - 1) / 2);
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(BoundedChannel, ParkingProducersAndConsumers) {
+    constexpr size_t THREADS_QUANTITY{ 4 }, ELEMENTS_QUANTITY{ 20000 };
+    BoundedChannel<size_t> channel(2);
+    std::atomic_size_t consumed{}, sum{};
+
+    std::vector<std::thread> consumers{};
+    for (size_t consumer{ 0 }; consumer < THREADS_QUANTITY; ++consumer)
+        consumers.emplace_back([&]() {
+            while (std::optional<size_t> element{ channel.Extract() }) {
+                sum += element.value();
+                ++consumed;
+            }
+        });
+    std::vector<std::thread> producers{};
+    for (size_t producer{ 0 }; producer < THREADS_QUANTITY; ++producer)
+        producers.emplace_back([&, producer]() {
+            for (size_t i{ producer }; i < ELEMENTS_QUANTITY; i += THREADS_QUANTITY)
+                ASSERT_TRUE(channel.Emplace(i));
+        });
+    for (std::thread& thread : producers)
+        thread.join();
+    channel.Close();
+    for (std::thread& thread : consumers)
+        thread.join();
+
+    ASSERT_FALSE(channel.Emplace(size_t{ 0 }));
+    ASSERT_EQ(static_cast<size_t>(consumed), ELEMENTS_QUANTITY);
+    ASSERT_EQ(static_cast<size_t>(sum), ELEMENTS_QUANTITY * (ELEMENTS_QUANTITY - 1) / 2);
+}
@@ -1,6 +1,8 @@
 #include "tests/test-unit-common.hpp"
 
 #include "parallel_executor.hpp"
+#include "thread_safe_container.hpp"
+#include "lock_free_ring.hpp"
 
 auto& main_cout = std::cout;
 
@@ -146,6 +148,76 @@ class ParallelExecutor_Tests : public testing::Test {
         ASSERT_EQ(static_cast<size_t>(counter), int_list.size());
     }
 
+    // NOTE: the results of threads are stored in the lock-free ring instead of ThreadSafeList-class
+    void Test7() {
+        size_t threads_quantity{ 32 };
+        std::atomic<uint32_t> counter{};
+        LockFreeRing<int32_t> int_ring(threads_quantity * INT8_MAX);
+        auto Func = [&]() -> void {
+            int32_t local_counter{ 0 };
+            while (++local_counter < INT8_MAX) {
+                ASSERT_TRUE(int_ring.emplace_back(std::rand()));
+                ++counter;
+            }
+        };
+
+        ParallelExecutor<Base> pe(threads_quantity);
+        auto unit = pe.Launch(Func);
+        unit.WaitWhileAllFinished<1000>();
+
+        ASSERT_EQ(unit.GetActiveThreads(), 0);
+        ASSERT_EQ(static_cast<size_t>(counter), int_ring.size());
+        size_t extracted{};
+        while (int_ring.ExtractFront().has_value())
+            ++extracted;
+        ASSERT_EQ(static_cast<size_t>(counter), extracted);
+    }
+
+    // NOTE: every element is changed by one thread only, so the elements are not protected
+    template<CHUNKING Chunking>
+    void Test8() {
+        std::vector<uint64_t> values(10007);
+        for (size_t i{ 0 }; i < values.size(); ++i)
+            values[i] = i;
+
+        ParallelExecutor<Base> pe(8);
+        for (const size_t grain : { 0, 1, 64, 100000 }) {
+            std::vector<uint64_t> squares{ values };
+            pe.template ParallelFor<Chunking>(squares, grain, [](uint64_t& value) { value *= value; });
+            for (size_t i{ 0 }; i < values.size(); ++i)
+                ASSERT_EQ(squares[i], values[i] * values[i]);
+        }
+        pe.template ParallelFor<Chunking>(std::vector<uint64_t>{}, 0, [](uint64_t&) { FAIL(); });
+    }
+
+    template<CHUNKING Chunking>
+    void Test9() {
+        std::vector<uint64_t> values(10007);
+        for (size_t i{ 0 }; i < values.size(); ++i)
+            values[i] = i;
+        const uint64_t expected_sum = values.size() * (values.size() - 1) / 2;
+
+        ParallelExecutor<Base> pe(8);
+        auto add = [](uint64_t&& accumulated, const uint64_t value) { return accumulated + value; };
+        auto combine = [](uint64_t&& left, uint64_t&& right) { return left + right; };
+        for (const size_t grain : { 0, 1, 64, 100000 })
+            ASSERT_EQ(pe.template ParallelReduce<Chunking>(values, grain, uint64_t{ 0 }, add, combine), expected_sum);
+        ASSERT_EQ(pe.template ParallelReduce<Chunking>(std::vector<uint64_t>{}, 0, uint64_t{ 0 }, add, combine), uint64_t{ 0 });
+
+        // NOTE: the partial results are not copied between threads, so the reduction can collect the containers
+        auto collect = [](std::vector<uint64_t>&& accumulated, const uint64_t value) {
+            accumulated.push_back(value);
+            return std::move(accumulated);
+        };
+        auto merge = [](std::vector<uint64_t>&& left, std::vector<uint64_t>&& right) {
+            left.insert(left.end(), right.begin(), right.end());
+            return std::move(left);
+        };
+        std::vector<uint64_t> collected = pe.template ParallelReduce<Chunking>(values, 16, std::vector<uint64_t>{}, collect, merge);
+        std::sort(collected.begin(), collected.end());
+        ASSERT_EQ(collected, values);
+    }
+
     void LaunchAllTests() {
         Test1();
         Test2();
@@ -153,6 +225,11 @@ class ParallelExecutor_Tests : public testing::Test {
         Test4();
         Test5();
         Test6();
+        Test7();
+        Test8<CHUNKING::STATIC>();
+        Test8<CHUNKING::DYNAMIC>();
+        Test9<CHUNKING::STATIC>();
+        Test9<CHUNKING::DYNAMIC>();
     }
 };
 
@@ -169,4 +246,101 @@ TEST_F(PE_ByFuture, Test) {
 using PE_ByAlg = ParallelExecutor_Tests<PARALLELIZATION_BASE::STD_FUTURE>;
 TEST_F(PE_ByAlg, Test) {
     LaunchAllTests();
-}
\ No newline at end of file
+}
+using PE_ByPool = ParallelExecutor_Tests<PARALLELIZATION_BASE::THREAD_POOL>;
+TEST_F(PE_ByPool, Test) {
+    LaunchAllTests();
+}
+
+TEST(PE_ByPool_Reuse, Test) {
+    auto thread_pool = std::make_shared<ThreadPool>();
+    ParallelExecutorTPL pe(8, thread_pool);
+    for (size_t i{ 0 }; i < 16; ++i) {
+        std::atomic<uint32_t> counter{};
+        auto unit = pe.Launch([&]() { ++counter; });
+        unit.WaitWhileAllFinished();
+        ASSERT_EQ(static_cast<uint32_t>(counter), 8);
+    }
+    ASSERT_LT(thread_pool->GetThreadsQuantity(), 8 * 16);
+}
+
+TEST(PE_StatusTable, Test) {
+    static_assert(alignof(ThreadStatus<int32_t>) == CACHE_LINE_SIZE && alignof(ThreadStatus<void>) == CACHE_LINE_SIZE);
+    auto thread_pool = std::make_shared<ThreadPool>();
+    ParallelExecutorTPL pe(256, thread_pool);
+    std::atomic<uint32_t> counter{};
+    auto unit = pe.Launch([&]() { return ++counter; });
+    ASSERT_TRUE(unit.WaitForFinish(std::chrono::milliseconds(1000)));
+    ASSERT_EQ(unit.GetLaunchedThreads(), size_t{ 256 });
+    ASSERT_EQ(unit.GetActiveThreads(), size_t{ 0 });
+    ASSERT_EQ(static_cast<uint32_t>(counter), 256);
+}
+
+TEST(PE_WaitForFinish, Test) {
+    auto thread_pool = std::make_shared<ThreadPool>();
+    ParallelExecutorTPL pe(2, thread_pool);
+    std::atomic_bool is_released{};
+    auto unit = pe.Launch([&]() {
+        while (!is_released.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    // NOTE: the timed waiting gives up while the threads are running, the waiting without the limit returns only when they are finished
+    ASSERT_FALSE(unit.WaitForFinish(std::chrono::milliseconds(10)));
+    ASSERT_EQ(unit.GetActiveThreads(), size_t{ 2 });
+    is_released.store(true);
+    unit.WaitWhileAllFinished<1000>();
+    ASSERT_EQ(unit.GetActiveThreads(), size_t{ 0 });
+    ASSERT_TRUE(unit.WaitForFinish(std::chrono::milliseconds(0)));
+}
+
+#ifdef __linux__
+TEST(PE_LaunchPolicy, Test) {
+    cpu_set_t process_cpus;
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(process_cpus), &process_cpus), 0);
+    LaunchPolicy policy{};
+    for (size_t cpu{ 0 }; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &process_cpus))
+            policy.cpus.push_back(cpu);
+    policy.pinning = PINNING::SPREAD;
+    policy.scheduling = SCHEDULING_CLASS::BATCH;
+
+    // NOTE: the worker reports the quantity of its CPUs, its first CPU and its scheduling class
+    auto worker = []() {
+        cpu_set_t cpus;
+        ::sched_getaffinity(0, sizeof(cpus), &cpus);
+        size_t first{ CPU_SETSIZE };
+        for (size_t cpu{ 0 }; cpu < CPU_SETSIZE && first == CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &cpus))
+                first = cpu;
+        return std::make_tuple(static_cast<size_t>(CPU_COUNT(&cpus)), first, ::sched_getscheduler(0));
+    };
+
+    auto thread_pool = std::make_shared<ThreadPool>();
+    ParallelExecutorTPL pe(4, thread_pool);
+    std::vector<std::tuple<size_t, size_t, int>> results = pe.SetLaunchPolicy(policy).Launch(worker).ExtractResults();
+    std::set<size_t> used_cpus{};
+    for (const auto& [cpus_quantity, first, scheduling] : results) {
+        ASSERT_EQ(cpus_quantity, size_t{ 1 });
+        ASSERT_EQ(scheduling, SCHED_BATCH);
+        used_cpus.emplace(first);
+    }
+    ASSERT_EQ(used_cpus.size(), std::min<size_t>(4, policy.cpus.size()));
+
+    // NOTE: the threads of the pool are given back with the settings which they had before the launch
+    results = pe.SetLaunchPolicy(LaunchPolicy{}).Launch(worker).ExtractResults();
+    for (const auto& [cpus_quantity, first, scheduling] : results) {
+        ASSERT_EQ(cpus_quantity, policy.cpus.size());
+        ASSERT_EQ(scheduling, SCHED_OTHER);
+    }
+
+    LaunchPolicy wrong_node{};
+    wrong_node.numa_nodes = { 4096 };
+    ASSERT_THROW(pe.SetLaunchPolicy(wrong_node), std::exception);
+    // NOTE: the resolved policy is taken as it is, its NUMA nodes are not read again
+    ASSERT_NO_THROW(pe.SetResolvedLaunchPolicy(wrong_node));
+    ASSERT_NO_THROW(pe.SetResolvedLaunchPolicy(LaunchPolicy{}));
+    LaunchPolicy first_node{};
+    first_node.numa_nodes = { 0 };
+    ASSERT_FALSE(first_node.Resolve().cpus.empty());
+}
+#endif
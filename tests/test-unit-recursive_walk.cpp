@@ -1,7 +1,15 @@
 #include "tests/test-unit-common.hpp"
 
+#include <map>
+
 #include "recursive_walk.hpp"
 
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#endif
+
 class RecursiveWalkingTesting : public testing::Test {
     public:
     using SetID = std::set<std::thread::id>;
@@ -94,6 +102,161 @@ class RecursiveWalkingTesting : public testing::Test {
         }
         _thread_ids.emplace(std::move(current_id));
     }
+
+    // brief: checks that every file and every directory of the test catalogs-tree is visited exactly once
+    template<WALK_TYPE Type, PARALLELIZATION_BASE Base, ENUMERATION_ENGINE Engine = ENUMERATION_ENGINE::STD_FILESYSTEM>
+    void CheckVisitedOnce() {
+        std::set<fs::path> expected_files{}, expected_dirs{};
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(GetTestDirectory()))
+            (entry.is_directory() ? expected_dirs : expected_files).emplace(entry.path());
+
+        std::mutex visited_mutex;
+        std::set<fs::path> files{}, dirs{};
+        auto Visit = [&](std::set<fs::path>& visited, const fs::path& path) {
+            std::lock_guard locker(visited_mutex);
+            ASSERT_TRUE(visited.emplace(path).second) << path;
+        };
+        RecursiveWalking<Type, Base, Engine>(GetDeep(), 8).WalkIn(
+            GetTestDirectory(), [&](size_t, const fs::path& path) { Visit(files, path); }, [&](size_t, const fs::path& path) { Visit(dirs, path); });
+
+        ASSERT_EQ(files, expected_files);
+        ASSERT_EQ(dirs, expected_dirs);
+    }
+
+#ifdef __linux__
+    template<ENUMERATION_ENGINE Engine>
+    void CheckBatches() {
+        std::set<fs::path> expected_entries{};
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(GetTestDirectory()))
+            expected_entries.emplace(entry.path());
+
+        std::mutex visited_mutex;
+        std::set<fs::path> entries{};
+        size_t batches{};
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine>(GetDeep(), 8)
+            .template WalkInBatches<true>(GetTestDirectory(), [&](size_t, const fs::path& dir, const EntriesView& batch) {
+                std::lock_guard locker(visited_mutex);
+                ++batches;
+                for (const EntryInfo& entry : batch) {
+                    const fs::path path = fs::path(dir).append(entry.name);
+                    ASSERT_TRUE(entries.emplace(path).second) << path;
+                    ASSERT_EQ(entry.is_directory, fs::is_directory(path)) << path;
+                    if (!entry.is_directory) {
+                        ASSERT_EQ(entry.size, fs::file_size(path)) << path;
+                    }
+                }
+            });
+
+        ASSERT_EQ(entries, expected_entries);
+        // NOTE: one batch per catalog of the tree including the initial catalog
+        ASSERT_EQ(batches, 1 + static_cast<size_t>(std::count_if(expected_entries.begin(), expected_entries.end(), [](const fs::path& path) { return fs::is_directory(path); })));
+    }
+
+    // brief: checks the paths of the sub catalogs of "/", the separator of the root catalog is not doubled
+    // note: the native strings are compared, because fs::path equals "//etc" to "/etc"
+    template<ENUMERATION_ENGINE Engine>
+    void CheckRootPaths() {
+        std::set<std::string> expected_dirs{};
+        for (const fs::directory_entry& entry : fs::directory_iterator("/"))
+            if (entry.is_directory())
+                expected_dirs.emplace(entry.path().native());
+
+        DirectoryEnumerator<Engine> enumerator{};
+        std::vector<typename DirectoryEnumerator<Engine>::DirectoryType> sub_dirs{};
+        enumerator.ForEach(enumerator.ToDirectory(fs::directory_entry("/")), [&](const auto& entry) {
+            if (entry.is_directory())
+                sub_dirs.emplace_back(enumerator.ToDirectory(entry));
+        });
+        std::set<std::string> dirs{};
+        for (const auto& sub_dir : sub_dirs)
+            dirs.emplace(enumerator.GetPath(sub_dir).native());
+
+        ASSERT_EQ(dirs, expected_dirs);
+        ASSERT_EQ(enumerator.GetPath(enumerator.ToDirectory(fs::directory_entry("/"))).native(), "/");
+    }
+
+    // brief: walks the wide tree under the lowered limit of descriptors of the process, the limit is restored after the walk
+    // note: in the walk on width all catalogs of the level wait in the queue while they keep the descriptors of their parents,
+    // | that is more than the process may open (see KeptDescriptors-class)
+    template<ENUMERATION_ENGINE Engine>
+    void CheckDescriptorsLimit() {
+        const fs::path root{ fs::current_path().append("test_directory_descriptors") };
+        fs::remove_all(root);
+        fs::create_directory(root);
+        _CreateTestCatalog(root, 3 /*deep*/, 12 /*catalogs*/, 1 /*files*/);
+        std::set<std::string> expected_files{}, expected_dirs{};
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root))
+            (entry.is_directory() ? expected_dirs : expected_files).emplace(entry.path().native());
+
+        rlimit original_limit{};
+        ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &original_limit), 0);
+        const rlimit lowered_limit{ 64, original_limit.rlim_max };
+        ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &lowered_limit), 0);
+        std::mutex visited_mutex;
+        std::set<std::string> files{}, dirs{};
+        auto Visit = [&](std::set<std::string>& visited, const fs::path& path) {
+            std::lock_guard locker(visited_mutex);
+            visited.emplace(path.native());
+        };
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, Engine>(SIZE_MAX, 2).WalkIn(
+            root, [&](size_t, const fs::path& path) { Visit(files, path); }, [&](size_t, const fs::path& path) { Visit(dirs, path); });
+        ::setrlimit(RLIMIT_NOFILE, &original_limit);
+
+        ASSERT_EQ(files, expected_files);
+        ASSERT_EQ(dirs, expected_dirs);
+        ASSERT_EQ(KeptDescriptors::GetKept(), size_t{ 0 });
+        fs::remove_all(root);
+    }
+
+    // brief: makes the syscall to fail with the error in the whole process, the filter of syscalls can not be removed
+    // return: false if the filter is not installed
+    static bool FailSyscall(const int syscall_number, const int error) {
+        sock_filter filter[]{
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<unsigned>(syscall_number), 0, 1),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | static_cast<unsigned>(error)),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        };
+        const sock_fprog program{ static_cast<unsigned short>(std::size(filter)), filter };
+        return ::prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0 && ::prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) == 0;
+    }
+
+    // brief: forbids io_uring_setup-syscall to the process, checks the walks of LINUX_IO_URING and exits with 0 if all checks are passed
+    // note: it is called in the child process of the death test, because the filter of syscalls can not be removed
+    void CheckWithoutIoUring() {
+        if (!FailSyscall(__NR_io_uring_setup, ENOSYS) || IoUring(64).IsValid())
+            std::exit(2);
+        CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+        CheckBatches<ENUMERATION_ENGINE::LINUX_IO_URING>();
+        std::exit(HasFailure() ? 1 : 0);
+    }
+
+    // brief: fails io_uring_enter-syscall in the process, so every ring is created, but its first submission fails;
+    // | checks that the withdrawn operations are canceled and the walks of LINUX_IO_URING are done synchronously, exits with 0 if all checks are passed
+    // note: it is called in the child process of the death test, because the filter of syscalls can not be removed
+    void CheckWithFailedSubmit() {
+        if (!FailSyscall(__NR_io_uring_enter, ENOMEM))
+            std::exit(2);
+        IoUring ring(8);
+        io_uring_sqe* const sqe = ring.PrepareSqe();
+        if (!sqe)
+            std::exit(3);
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = 42;
+        EXPECT_EQ(ring.Submit(), ENOMEM);
+        EXPECT_FALSE(ring.IsValid());
+        EXPECT_EQ(ring.PrepareSqe(), nullptr);
+        std::vector<std::pair<uint64_t, int>> completions{};
+        auto collect = [&](const uint64_t user_data, const int result) { completions.emplace_back(user_data, result); };
+        ring.WaitAll(collect);
+        EXPECT_EQ(ring.GetInFlight(), 0u);
+        EXPECT_EQ(completions, (std::vector<std::pair<uint64_t, int>>{ { 42, -ECANCELED } }));
+
+        CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+        CheckBatches<ENUMERATION_ENGINE::LINUX_IO_URING>();
+        std::exit(HasFailure() ? 1 : 0);
+    }
+#endif
 #pragma endregion target
 }; // class RecursiveWalkingTesting
 
@@ -125,3 +288,561 @@ TEST_F(RecursiveWalkingTesting, WalkTestOnWidth_STD_FUTURE) {
 TEST_F(RecursiveWalkingTesting, WalkTestOnWidth_STL_ALGORITHMS) {
     RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STL_ALGORITHMS>(GetDeep()).WalkIn(GetTestDirectory(), action_with_file, action_with_dir);
 }
+
+// NOTE: visit counting tests
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnLenght_STD_THREAD) {
+    CheckVisitedOnce<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::STD_THREAD>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnWidth_STD_THREAD) {
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnLenght_THREAD_POOL) {
+    CheckVisitedOnce<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnWidth_THREAD_POOL) {
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL>();
+}
+
+// NOTE: incremental walk tests
+
+TEST_F(RecursiveWalkingTesting, WalkInIncremental_THREAD_POOL) {
+    const fs::path root = fs::current_path().append("test_directory_incremental");
+    const fs::path index_file = fs::current_path().append("test_directory_incremental.index");
+    fs::remove_all(root);
+    for (size_t i{ 1 }; i <= 3; ++i)
+        for (size_t j{ 1 }; j <= 2; ++j) {
+            const fs::path dir = fs::path(root).append("dir_" + std::to_string(i)).append("dir_" + std::to_string(j));
+            fs::create_directories(dir);
+            for (size_t k{ 1 }; k <= 3; ++k)
+                std::ofstream(fs::path(dir).append("file_" + std::to_string(k) + ".txt")).close();
+        }
+    // NOTE: the catalogs changed just before the walk are rescanned by the next walk anyway, so their modification time is moved to the past
+    fs::last_write_time(root, fs::file_time_type::clock::now() - std::chrono::hours(1));
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root))
+        if (entry.is_directory())
+            fs::last_write_time(entry.path(), fs::file_time_type::clock::now() - std::chrono::hours(1));
+
+    using Entries = std::map<fs::path, bool /*is_changed*/>;
+    auto walk = [&]() {
+        std::mutex entries_mutex;
+        Entries entries{};
+        auto action = [&](size_t, const fs::path& path, bool is_changed) {
+            std::lock_guard locker(entries_mutex);
+            ASSERT_TRUE(entries.emplace(path, is_changed).second) << path;
+        };
+        RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL>(GetDeep(), 8).WalkInIncremental(root, index_file, action, action);
+        return entries;
+    };
+    auto count_changed = [](const Entries& entries) {
+        return static_cast<size_t>(std::count_if(entries.begin(), entries.end(), [](const auto& entry) { return entry.second; }));
+    };
+
+    const Entries first_walk{ walk() };
+    ASSERT_EQ(first_walk.size(), size_t{ 3 + 3 * 2 + 3 * 2 * 3 });
+    ASSERT_EQ(count_changed(first_walk), first_walk.size());
+
+    const Entries second_walk{ walk() };
+    ASSERT_EQ(second_walk.size(), first_walk.size());
+    ASSERT_EQ(count_changed(second_walk), size_t{ 0 });
+
+    const fs::path changed_dir = fs::path(root).append("dir_2").append("dir_1");
+    std::ofstream(fs::path(changed_dir).append("file_4.txt")).close();
+    const Entries third_walk{ walk() };
+    ASSERT_EQ(third_walk.size(), first_walk.size() + 1);
+    ASSERT_EQ(count_changed(third_walk), size_t{ 4 });
+    for (const auto& [path, is_changed] : third_walk)
+        ASSERT_EQ(is_changed, path.parent_path() == changed_dir) << path;
+
+    fs::remove_all(root);
+    fs::remove(index_file);
+}
+
+// NOTE: stream tests
+
+TEST_F(RecursiveWalkingTesting, WalkInStream_THREAD_POOL) {
+    std::set<fs::path> expected_files{}, expected_dirs{};
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(GetTestDirectory()))
+        (entry.is_directory() ? expected_dirs : expected_files).emplace(entry.path());
+
+    std::set<fs::path> files{}, dirs{};
+    // NOTE: the minimal capacity makes walkers wait for the caller after every entry
+    for (const StreamEntry& entry : RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL>(GetDeep(), 8).WalkInStream(GetTestDirectory(), 1))
+        ASSERT_TRUE((entry.is_directory ? dirs : files).emplace(entry.path).second) << entry.path;
+
+    ASSERT_EQ(files, expected_files);
+    ASSERT_EQ(dirs, expected_dirs);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInInstrumented_THREAD_POOL) {
+    size_t expected_files{}, expected_dirs{};
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(GetTestDirectory()))
+        ++(entry.is_directory() ? expected_dirs : expected_files);
+
+    constexpr size_t THREADS_QUANTITY{ 4 };
+    using InstrumentedWalking = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::STD_FILESYSTEM, true>;
+    // NOTE: without the trace only the counters are collected
+    const WalkStats counters = InstrumentedWalking(SIZE_MAX, THREADS_QUANTITY).WalkIn(GetTestDirectory(), [&](size_t, const fs::path&) {});
+    ASSERT_FALSE(counters.is_tracing);
+    ASSERT_EQ(counters.GetTotal().directories, expected_dirs + 1);
+    for (const WalkStats::WorkerStats& worker : counters.workers)
+        ASSERT_TRUE(worker.events.empty());
+
+    std::atomic_size_t files{};
+    const WalkStats stats = InstrumentedWalking(SIZE_MAX, THREADS_QUANTITY).SetTracing(true).WalkIn(GetTestDirectory(), [&](size_t, const fs::path&) { ++files; });
+    const WalkStats::WorkerStats total = stats.GetTotal();
+
+    ASSERT_EQ(stats.workers.size(), THREADS_QUANTITY);
+    ASSERT_EQ(static_cast<size_t>(files), expected_files);
+    ASSERT_EQ(total.entries, expected_files + expected_dirs);
+    // NOTE: the initial catalog is added to the queue before the start of walkers
+    ASSERT_EQ(total.directories, expected_dirs + 1);
+    ASSERT_EQ(total.pops, expected_dirs + 1);
+    ASSERT_EQ(total.pushes, expected_dirs);
+    ASSERT_GT(stats.duration_ns, uint64_t{ 0 });
+
+    std::stringstream trace{};
+    stats.WriteChromeTrace(trace);
+    const std::string trace_json = trace.str();
+    ASSERT_EQ(trace_json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), size_t{ 0 });
+    size_t scans{};
+    for (size_t position{ trace_json.find("\"scan\"") }; position != std::string::npos; position = trace_json.find("\"scan\"", position + 1))
+        ++scans;
+    ASSERT_EQ(scans, total.directories);
+}
+
+// brief: checks the adaptive quantity of walkers on the wide tree, the walkers are retired and added many times during the walk
+// note: the catalogs which are queued by the retired walker keep the data of its enumerator (see PathArena-class), so the paths are checked too
+template<ENUMERATION_ENGINE Engine>
+static void CheckAdaptive(const WalkScaling& scaling) {
+    using InstrumentedWalking = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, Engine, true>;
+    const fs::path root{ fs::current_path().append("test_directory_adaptive") };
+    fs::remove_all(root);
+    fs::create_directory(root);
+    std::function<void(const fs::path&, size_t)> create_tree = [&](const fs::path& dir, const size_t deep) {
+        for (size_t i{ 1 }; deep > 0 && i <= 6; ++i) {
+            const fs::path sub_dir = fs::path(dir).append("sub_dir_" + std::to_string(i));
+            fs::create_directory(sub_dir);
+            create_tree(sub_dir, deep - 1);
+        }
+        std::ofstream(fs::path(dir).append("file")).close();
+    };
+    create_tree(root, 4);
+
+    std::set<fs::path> expected_files{};
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root))
+        if (!entry.is_directory())
+            expected_files.emplace(entry.path());
+    std::mutex files_mutex;
+    std::set<fs::path> files{};
+    const WalkStats stats = InstrumentedWalking(SIZE_MAX).SetScaling(scaling).WalkIn(root, [&](size_t, const fs::path& path) {
+        std::lock_guard locker(files_mutex);
+        files.emplace(path);
+    });
+    fs::remove_all(root);
+    ASSERT_EQ(files, expected_files);
+    ASSERT_EQ(stats.workers.size(), scaling.max_workers);
+    ASSERT_GT(stats.peak_workers, scaling.min_workers);
+    ASSERT_LE(stats.peak_workers, scaling.max_workers);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInAdaptive_THREAD_POOL) {
+    using InstrumentedWalking = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::STD_FILESYSTEM, true>;
+    // NOTE: the stalls are not counted, so only the length of the queue adds walkers
+    WalkScaling scaling{};
+    scaling.min_workers = 1;
+    scaling.max_workers = 8;
+    scaling.stall_threshold = std::chrono::hours(1);
+    scaling.retire_delay = std::chrono::milliseconds(1);
+
+    CheckAdaptive<ENUMERATION_ENGINE::STD_FILESYSTEM>(scaling);
+#ifdef __linux__
+    CheckAdaptive<ENUMERATION_ENGINE::LINUX_OPENAT>(scaling);
+    CheckAdaptive<ENUMERATION_ENGINE::LINUX_IO_URING>(scaling);
+#endif
+
+    // NOTE: the chain of catalogs has one pending catalog at most, so one walker is enough for it
+    const fs::path chain{ fs::current_path().append("test_directory_chain") };
+    fs::path last{ chain };
+    for (size_t i{ 0 }; i < 20; ++i)
+        last.append("sub_dir");
+    fs::create_directories(last);
+    std::atomic_size_t dirs{};
+    const WalkStats chain_stats = InstrumentedWalking(SIZE_MAX).SetScaling(scaling).WalkIn(chain, std::nullopt, [&](size_t, const fs::path&) { ++dirs; });
+    fs::remove_all(chain);
+    ASSERT_EQ(static_cast<size_t>(dirs), size_t{ 20 });
+    ASSERT_EQ(chain_stats.peak_workers, size_t{ 1 });
+
+    ASSERT_THROW((RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD>().SetScaling(scaling)), std::exception);
+    scaling.min_workers = 0;
+    ASSERT_THROW(InstrumentedWalking().SetScaling(scaling), std::exception);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInControlled_THREAD_POOL) {
+    RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL> walking(SIZE_MAX, 4);
+    size_t expected_entries{}, skipped_entries{};
+    const fs::path skipped_dir = GetTestDirectory().append("sub_dir_1");
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(GetTestDirectory())) {
+        ++expected_entries;
+        skipped_entries += entry.path().native().rfind(skipped_dir.native() + fs::path::preferred_separator, 0) == 0;
+    }
+
+    std::mutex visited_mutex;
+    std::set<fs::path> visited{};
+    auto visit = [&](size_t, const fs::path& path) {
+        std::lock_guard locker(visited_mutex);
+        visited.emplace(path);
+        return path == skipped_dir ? WALK_DECISION::SKIP_SUBTREE : WALK_DECISION::CONTINUE;
+    };
+    WalkOutcome outcome = walking.WalkIn(GetTestDirectory(), WalkLimits{}, visit, visit);
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::COMPLETED);
+    ASSERT_EQ(outcome.entries, expected_entries - skipped_entries);
+    ASSERT_EQ(visited.size(), expected_entries - skipped_entries);
+    ASSERT_TRUE(visited.count(skipped_dir));
+
+    // NOTE: the search of the first match stops all walkers
+    std::atomic_size_t calls{};
+    outcome = walking.WalkIn(GetTestDirectory(), WalkLimits{}, [&](size_t, const fs::path& path) {
+        ++calls;
+        return path.filename().native().rfind("file_3", 0) == 0 ? WALK_DECISION::STOP : WALK_DECISION::CONTINUE;
+    });
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::STOPPED_BY_ACTION);
+    ASSERT_EQ(outcome.entries, static_cast<size_t>(calls));
+    ASSERT_LT(outcome.entries, expected_entries);
+
+    WalkLimits budget{};
+    budget.entry_budget = 10;
+    calls = 0;
+    outcome = walking.WalkIn(GetTestDirectory(), budget, [&](size_t, const fs::path&) { return ++calls, WALK_DECISION::CONTINUE; }, visit);
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::BUDGET);
+    ASSERT_EQ(outcome.entries, size_t{ 10 });
+
+    WalkLimits cancelled{};
+    cancelled.stop_token.emplace().RequestStop();
+    outcome = walking.WalkIn(GetTestDirectory(), cancelled, visit);
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::CANCELLED);
+    ASSERT_EQ(outcome.entries, size_t{ 0 });
+
+    WalkLimits expired{};
+    expired.deadline = std::chrono::steady_clock::now();
+    outcome = walking.WalkIn(GetTestDirectory(), expired, visit);
+    ASSERT_EQ(outcome.reason, WALK_STOP_REASON::DEADLINE);
+    ASSERT_EQ(outcome.entries, size_t{ 0 });
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInStream_Cancel_STD_THREAD) {
+    auto stream = RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::STD_THREAD>(GetDeep(), 8).WalkInStream(GetTestDirectory(), 2);
+    for (size_t i{ 0 }; i < 3; ++i)
+        ASSERT_TRUE(stream.Next().has_value());
+
+    stream.Cancel();
+    size_t remaining{};
+    while (stream.Next().has_value())
+        ++remaining;
+    ASSERT_LE(remaining, 2);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInContent_THREAD_POOL) {
+    const fs::path root = fs::current_path().append("test_directory_content");
+    fs::remove_all(root);
+    fs::create_directories(fs::path(root).append("dir_1").append("dir_2"));
+
+    // NOTE: the sizes cover the empty file, the small file which is read by pread and the files which are mapped with CONTENT_READING::AUTO
+    std::map<fs::path, std::string> expected{};
+    const std::vector<size_t> sizes{ 0, 100, FileContent::MMAP_THRESHOLD, FileContent::READ_CHUNK_SIZE * 2 + 7 };
+    for (const fs::path& dir : { root, fs::path(root).append("dir_1"), fs::path(root).append("dir_1").append("dir_2") })
+        for (size_t i{ 0 }; i < sizes.size(); ++i) {
+            const fs::path file = fs::path(dir).append("file_" + std::to_string(i));
+            std::string& content = expected[file];
+            for (size_t j{ 0 }; j < sizes[i]; ++j)
+                content.push_back(static_cast<char>('a' + (j + i) % 26));
+            std::ofstream(file, std::ios_base::binary) << content;
+        }
+#ifdef __linux__
+    // NOTE: the reader must skip FIFO instead of waiting for its writer
+    ASSERT_EQ(::mkfifo(fs::path(root).append("dir_1").append("fifo").c_str(), 0600), 0);
+#endif
+
+    for (const CONTENT_READING reading : { CONTENT_READING::AUTO, CONTENT_READING::MMAP, CONTENT_READING::PREAD }) {
+        std::mutex contents_mutex;
+        std::map<fs::path, std::string> contents{};
+        ContentPipelineOptions options{};
+        options.readers_quantity = 2;
+        options.processors_quantity = 3;
+        // NOTE: the minimal capacities make every stage wait for the next one
+        options.paths_capacity = 1;
+        options.contents_capacity = 1;
+        options.reading = reading;
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL>(SIZE_MAX, 4).WalkInContent(
+            root,
+            [&](size_t, const fs::path& path, std::string_view content) {
+                std::lock_guard locker(contents_mutex);
+                ASSERT_TRUE(contents.emplace(path, std::string(content)).second) << path;
+            },
+            options);
+        ASSERT_EQ(contents, expected);
+    }
+    fs::remove_all(root);
+}
+
+// brief: walks in the tree with the catalogs which must be pruned by the filter and checks the found files and the quantity of scanned catalogs
+template<ENUMERATION_ENGINE Engine>
+void CheckFilter() {
+    const fs::path root = fs::current_path().append("test_directory_filter");
+    fs::remove_all(root);
+    for (const char* const dir : { "src", ".git/objects", "node_modules/pkg", "build_out" })
+        fs::create_directories(fs::path(root).append(dir));
+    auto write = [&](const char* const file, const size_t size) { std::ofstream(fs::path(root).append(file)) << std::string(size, 'x'); };
+    write("README.md", 100);
+    write("src/a.cpp", 100);
+    write("src/b.json", 1);
+    write("src/big.json", 1000);
+    write(".git/objects/x.json", 100);
+    write("node_modules/pkg/index.json", 100);
+    write("build_out/obj.json", 100);
+
+    WalkFilter filter{};
+    filter.extensions = { ".json", ".md" };
+    filter.exclude_directories = { ".git", "node_modules", "build*" };
+    filter.min_size = 10;
+
+    std::mutex found_mutex;
+    std::set<fs::path> files{}, dirs{};
+    auto collect = [&](std::set<fs::path>& found) {
+        return [&](size_t, const fs::path& path) {
+            std::lock_guard locker(found_mutex);
+            found.emplace(path);
+        };
+    };
+    const WalkStats stats =
+        RecursiveWalking<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, Engine, true>(SIZE_MAX, 4).WalkIn(root, filter, collect(files), collect(dirs));
+    ASSERT_EQ(files, (std::set<fs::path>{ fs::path(root).append("README.md"), fs::path(root).append("src").append("big.json") }));
+    ASSERT_EQ(dirs, (std::set<fs::path>{ fs::path(root).append("src") }));
+    // NOTE: only the initial catalog and "src" are opened, the excluded catalogs are pruned before the scan
+    ASSERT_EQ(stats.GetTotal().directories, size_t{ 2 });
+
+    // NOTE: the glob with '?' and the regular expression, the catalogs are not excluded
+    WalkFilter names_filter{};
+    names_filter.names = { "b?g.*", "*.md" };
+    names_filter.name_regex = "^(big|READ)";
+    names_filter.file_types = { FILE_TYPE::REGULAR };
+    files.clear();
+    RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, Engine>(SIZE_MAX, 4).WalkIn(root, names_filter, collect(files));
+    ASSERT_EQ(files, (std::set<fs::path>{ fs::path(root).append("README.md"), fs::path(root).append("src").append("big.json") }));
+    fs::remove_all(root);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInFiltered_STD_FILESYSTEM) {
+    CheckFilter<ENUMERATION_ENGINE::STD_FILESYSTEM>();
+}
+
+// brief: the reference order of the sorted walk: every catalog is followed by its sub tree, the entries of every catalog are sorted by name
+static void CollectSorted(const fs::path& dir, const size_t deep, const size_t max_deep, std::vector<std::pair<size_t, fs::path>>& result) {
+    std::vector<fs::directory_entry> entries{ fs::directory_iterator(dir), fs::directory_iterator() };
+    std::sort(entries.begin(), entries.end(), [](const fs::directory_entry& left, const fs::directory_entry& right) {
+        return left.path().native() < right.path().native();
+    });
+    for (const fs::directory_entry& entry : entries) {
+        if (entry.is_directory() && deep >= max_deep)
+            continue;
+        result.emplace_back(deep, entry.path());
+        if (entry.is_directory())
+            CollectSorted(entry.path(), deep + 1, max_deep, result);
+    }
+}
+
+// brief: checks the order of the sorted walk, the small capacity parks the walkers, so the emitter scans the most of catalogs itself
+template<PARALLELIZATION_BASE Base, ENUMERATION_ENGINE Engine>
+void CheckSorted(const fs::path& root, const size_t deep, const size_t capacity) {
+    std::vector<std::pair<size_t, fs::path>> expected{};
+    CollectSorted(root, 0, deep, expected);
+
+    std::vector<std::pair<size_t, fs::path>> emitted{};
+    const std::thread::id caller_id{ std::this_thread::get_id() };
+    auto emit = [&](size_t entry_deep, const fs::path& path) {
+        ASSERT_EQ(std::this_thread::get_id(), caller_id);
+        emitted.emplace_back(entry_deep, path);
+    };
+    RecursiveWalking<WALK_TYPE::WIDTH, Base, Engine>(deep, 4).WalkInSorted(root, emit, emit, capacity);
+    ASSERT_EQ(emitted, expected);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInSorted_THREAD_POOL) {
+    CheckSorted<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::STD_FILESYSTEM>(GetTestDirectory(), SIZE_MAX, 65536);
+    CheckSorted<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::STD_FILESYSTEM>(GetTestDirectory(), 1, 1);
+}
+
+#ifdef __linux__
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnLenght_LINUX_GETDENTS) {
+    CheckVisitedOnce<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_GETDENTS>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnWidth_LINUX_GETDENTS) {
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_GETDENTS>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnLenght_LINUX_OPENAT) {
+    CheckVisitedOnce<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnWidth_LINUX_OPENAT) {
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnLenght_LINUX_IO_URING) {
+    CheckVisitedOnce<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+TEST_F(RecursiveWalkingTesting, VisitedOnceOnWidth_LINUX_IO_URING) {
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInEntries_LINUX_OPENAT) {
+    std::atomic_size_t files{}, json_files{};
+    RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(GetDeep(), 8)
+        .WalkInEntries(GetTestDirectory(), [&](size_t, const auto& entry) {
+            ++files;
+            if (entry.name().find(".json") != std::string_view::npos) {
+                ++json_files;
+                ASSERT_TRUE(fs::is_regular_file(entry.path())) << entry.path();
+            }
+        });
+    ASSERT_GT(static_cast<size_t>(files), static_cast<size_t>(json_files));
+}
+TEST_F(RecursiveWalkingTesting, WalkInFiltered_LINUX_OPENAT) {
+    CheckFilter<ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInSorted_LINUX_OPENAT) {
+    CheckSorted<PARALLELIZATION_BASE::STD_THREAD, ENUMERATION_ENGINE::LINUX_OPENAT>(GetTestDirectory(), SIZE_MAX, 1);
+    CheckSorted<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(GetTestDirectory(), SIZE_MAX, 16);
+
+    // NOTE: on the larger tree the walkers finish the queue and return while the emitter still scans the catalogs which they have found
+    const fs::path root{ fs::current_path().append("test_directory_sorted") };
+    fs::remove_all(root);
+    fs::create_directory(root);
+    std::function<void(const fs::path&, size_t)> create_tree = [&](const fs::path& dir, const size_t deep) {
+        for (size_t i{ 1 }; deep > 0 && i <= 6; ++i) {
+            const fs::path sub_dir = fs::path(dir).append("sub_dir_" + std::to_string(i));
+            fs::create_directory(sub_dir);
+            create_tree(sub_dir, deep - 1);
+        }
+        for (size_t i{ 1 }; i <= 5; ++i)
+            std::ofstream(fs::path(dir).append("file_" + std::to_string(i))).close();
+    };
+    create_tree(root, 4);
+    for (size_t attempt{ 0 }; attempt < 10; ++attempt)
+        CheckSorted<PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_OPENAT>(root, SIZE_MAX, 64);
+    fs::remove_all(root);
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInBatches_LINUX_GETDENTS) {
+    CheckBatches<ENUMERATION_ENGINE::LINUX_GETDENTS>();
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInBatches_LINUX_OPENAT) {
+    CheckBatches<ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(RecursiveWalkingTesting, WalkInBatches_LINUX_IO_URING) {
+    CheckBatches<ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+TEST_F(RecursiveWalkingTesting, RootPaths_LINUX_OPENAT) {
+    CheckRootPaths<ENUMERATION_ENGINE::LINUX_GETDENTS>();
+    CheckRootPaths<ENUMERATION_ENGINE::LINUX_OPENAT>();
+    CheckRootPaths<ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+TEST_F(RecursiveWalkingTesting, DescriptorsLimit_LINUX_OPENAT) {
+    CheckDescriptorsLimit<ENUMERATION_ENGINE::LINUX_OPENAT>();
+}
+
+TEST_F(RecursiveWalkingTesting, DescriptorsLimit_LINUX_IO_URING) {
+    CheckDescriptorsLimit<ENUMERATION_ENGINE::LINUX_IO_URING>();
+}
+
+// NOTE: the queue of one operation makes every prefetched opening compete with the synchronous fallback (see PendingOpen-struct)
+TEST_F(RecursiveWalkingTesting, SmallQueue_LINUX_IO_URING) {
+    using EnumeratorType = DirectoryEnumerator<ENUMERATION_ENGINE::LINUX_IO_URING>;
+    const unsigned queue_depth{ EnumeratorType::GetQueueDepth() };
+    EnumeratorType::SetQueueDepth(1);
+    CheckVisitedOnce<WALK_TYPE::WIDTH, PARALLELIZATION_BASE::THREAD_POOL, ENUMERATION_ENGINE::LINUX_IO_URING>();
+    CheckBatches<ENUMERATION_ENGINE::LINUX_IO_URING>();
+    EnumeratorType::SetQueueDepth(queue_depth);
+}
+
+// NOTE: io_uring is disabled in the child process by seccomp, like in the containers which forbid it, so the enumerator works synchronously
+TEST_F(RecursiveWalkingTesting, UnavailableRing_LINUX_IO_URING) {
+    ASSERT_FALSE(IoUring(0).IsValid());
+    ASSERT_EQ(IoUring(0).Reap([](uint64_t, int) {}), 0u);
+
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(CheckWithoutIoUring(), testing::ExitedWithCode(0), "");
+}
+
+// NOTE: io_uring_enter fails in the child process, so every ring stops being valid at its first submission
+TEST_F(RecursiveWalkingTesting, FailedSubmit_LINUX_IO_URING) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(CheckWithFailedSubmit(), testing::ExitedWithCode(0), "");
+}
+
+TEST_F(RecursiveWalkingTesting, WatchIn_THREAD_POOL) {
+    const fs::path root = fs::current_path().append("test_directory_watch");
+    fs::remove_all(root);
+    fs::create_directories(fs::path(root).append("dir_1").append("dir_2"));
+    std::ofstream(fs::path(root).append("dir_1").append("file_1.txt")).close();
+
+    // NOTE: the tree is rebuilt by the events and is compared with the real tree
+    std::mutex tree_mutex;
+    std::set<fs::path> tree{};
+    std::set<fs::path> touched{};
+    auto action = [&](size_t, const fs::path& path, WATCH_EVENT event) {
+        std::lock_guard locker(tree_mutex);
+        touched.emplace(path);
+        if (event == WATCH_EVENT::EXISTING || event == WATCH_EVENT::CREATED || event == WATCH_EVENT::MOVED_TO)
+            ASSERT_TRUE(tree.emplace(path).second) << path;
+        else
+            ASSERT_EQ(tree.erase(path), size_t{ 1 }) << path;
+    };
+    auto get_real_tree = [&]() {
+        std::set<fs::path> result{};
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root))
+            result.emplace(entry.path());
+        return result;
+    };
+    auto process_while_differs = [&](auto& watcher) {
+        const std::set<fs::path> expected{ get_real_tree() };
+        for (size_t i{ 0 }; i < 100 && tree != expected; ++i)
+            watcher.Process(std::chrono::milliseconds(50));
+        ASSERT_EQ(tree, expected);
+    };
+
+    auto watcher = RecursiveWalking<WALK_TYPE::LENGTH, PARALLELIZATION_BASE::THREAD_POOL>(SIZE_MAX, 8).WatchIn(root, action, action);
+    ASSERT_EQ(tree, get_real_tree());
+    ASSERT_EQ(watcher.GetWatchedDirectoriesQuantity(), size_t{ 3 });
+
+    fs::create_directories(fs::path(root).append("dir_3").append("dir_4"));
+    std::ofstream(fs::path(root).append("dir_3").append("dir_4").append("file_2.txt")).close();
+    fs::remove(fs::path(root).append("dir_1").append("file_1.txt"));
+    process_while_differs(watcher);
+    ASSERT_EQ(watcher.GetWatchedDirectoriesQuantity(), size_t{ 5 });
+
+    fs::rename(fs::path(root).append("dir_3"), fs::path(root).append("dir_1").append("dir_3"));
+    std::ofstream(fs::path(root).append("temporary.txt")).close();
+    fs::remove(fs::path(root).append("temporary.txt"));
+    process_while_differs(watcher);
+    ASSERT_EQ(watcher.GetWatchedDirectoriesQuantity(), size_t{ 5 });
+    // NOTE: the creation and the deletion of the same file inside one batch are not given to the actions
+    ASSERT_EQ(touched.count(fs::path(root).append("temporary.txt")), size_t{ 0 });
+
+    fs::remove_all(fs::path(root).append("dir_1"));
+    process_while_differs(watcher);
+    ASSERT_EQ(watcher.GetWatchedDirectoriesQuantity(), size_t{ 1 });
+
+    fs::remove_all(root);
+}
+#endif
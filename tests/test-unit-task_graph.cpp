@@ -0,0 +1,76 @@
+#include "tests/test-unit-common.hpp"
+
+#include <numeric>
+
+#include "task_graph.hpp"
+#include "parallel_executor.hpp"
+
+TEST(TaskGraph, ContinuationsAndAggregation) {
+    TaskGraph graph{};
+    auto numbers = graph.Add([]() {
+        std::vector<uint64_t> result(1000);
+        for (size_t i{ 0 }; i < result.size(); ++i)
+            result[i] = i;
+        return result;
+    });
+    // NOTE: every copy sums own part of numbers, the partial sums are aggregated by the continuation
+    constexpr size_t COPIES_QUANTITY{ 4 };
+    auto partial_sums = graph.AddParallel(
+        COPIES_QUANTITY,
+        [numbers](const size_t copy) {
+            uint64_t sum{};
+            for (size_t i{ copy }; i < numbers.GetResult().size(); i += COPIES_QUANTITY)
+                sum += numbers.GetResult()[i];
+            return sum;
+        },
+        numbers);
+    auto sum = graph.Then(partial_sums, [](const std::vector<uint64_t>& sums) { return std::accumulate(sums.begin(), sums.end(), uint64_t{ 0 }); });
+    auto text = graph.Then(sum, [](const uint64_t value) { return std::to_string(value); });
+
+    graph.Run();
+    graph.Wait();
+    ASSERT_EQ(partial_sums.GetResult().size(), COPIES_QUANTITY);
+    ASSERT_EQ(sum.GetResult(), uint64_t{ 499500 });
+    ASSERT_EQ(text.GetResult(), "499500");
+    ASSERT_THROW(graph.Add([]() {}), std::exception);
+}
+
+TEST(TaskGraph, BranchesDoNotWaitForEachOther) {
+    TaskGraph graph{};
+    std::atomic_bool is_slow_finished{ false }, is_fast_continued{ false }, is_fast_continued_before_slow{ false };
+    std::mutex slow_mutex{};
+    std::unique_lock slow_lock(slow_mutex);
+
+    auto slow = graph.Add([&]() {
+        std::lock_guard lock(slow_mutex);
+        is_slow_finished = true;
+    });
+    auto fast = graph.Add([]() { return 1; });
+    auto fast_continuation = graph.Then(fast, [&](const int value) {
+        is_fast_continued_before_slow = !is_slow_finished;
+        is_fast_continued = true;
+        return value + 1;
+    });
+    std::atomic_size_t joined{};
+    graph.Add([&]() { ++joined; }, slow, fast_continuation);
+
+    graph.Run();
+    // NOTE: the slow branch is blocked until the continuation of the fast branch is finished
+    while (!is_fast_continued)
+        std::this_thread::yield();
+    slow_lock.unlock();
+    graph.Wait();
+
+    ASSERT_TRUE(is_fast_continued_before_slow);
+    ASSERT_EQ(fast_continuation.GetResult(), 2);
+    ASSERT_EQ(static_cast<size_t>(joined), size_t{ 1 });
+}
+
+TEST(ParallelizationUnit, ExtractResults) {
+    std::atomic_int32_t counter{};
+    auto unit = ParallelExecutorTPL(8).Launch([&]() { return ++counter; });
+    std::vector<int32_t> results = unit.ExtractResults();
+    std::sort(results.begin(), results.end());
+    ASSERT_EQ(results, (std::vector<int32_t>{ 1, 2, 3, 4, 5, 6, 7, 8 }));
+    ASSERT_TRUE(unit.ExtractResults().empty());
+}
@@ -0,0 +1,59 @@
+#include "tests/test-unit-common.hpp"
+
+#include "thread_safe_container.hpp"
+
+template<class ContainerType>
+class ThreadSafeContainer_Tests : public testing::Test {};
+
+using ContainerTypes = testing::Types<ThreadSafeList<std::string>, ThreadSafeVector<std::string>>;
+TYPED_TEST_SUITE(ThreadSafeContainer_Tests, ContainerTypes);
+
+TYPED_TEST(ThreadSafeContainer_Tests, ExtractFrontKeepsOrder) {
+    TypeParam container{};
+    for (size_t i{ 0 }; i < 100; ++i)
+        container.emplace_back(std::to_string(i));
+
+    for (size_t i{ 0 }; i < 100; ++i) {
+        ASSERT_EQ(container.ExtractFront(), std::to_string(i));
+        ASSERT_EQ(container.size(), 99 - i);
+        // NOTE: the iteration starts from the first not extracted element
+        if (i < 99) {
+            ASSERT_EQ(*container.begin(), std::to_string(i + 1));
+        }
+    }
+    ASSERT_FALSE(container.ExtractFront().has_value());
+}
+
+TYPED_TEST(ThreadSafeContainer_Tests, EmplaceFrontAfterExtraction) {
+    TypeParam container{};
+    container.emplace_back("1");
+    container.emplace_back("2");
+    ASSERT_EQ(container.ExtractFront(), "1");
+    container.emplace_front("0");
+    container.emplace_front("-1");
+
+    std::vector<std::string> expected{ "-1", "0", "2" };
+    ASSERT_TRUE(std::equal(container.begin(), container.end(), expected.begin(), expected.end()));
+}
+
+TYPED_TEST(ThreadSafeContainer_Tests, BatchedOperations) {
+    TypeParam container{};
+    std::vector<std::string> elements{};
+    for (size_t i{ 0 }; i < 10; ++i)
+        elements.emplace_back(std::to_string(i));
+    container.emplace_back_range(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+    ASSERT_EQ(container.size(), size_t{ 10 });
+
+    const std::vector<std::string> batch = container.ExtractFrontBatch(4);
+    ASSERT_EQ(batch, (std::vector<std::string>{ "0", "1", "2", "3" }));
+    ASSERT_EQ(container.ExtractFrontBatch(100).size(), size_t{ 6 });
+    ASSERT_TRUE(container.ExtractFrontBatch(1).empty());
+
+    container.emplace_back("a");
+    container.emplace_back("b");
+    ASSERT_EQ(container.ExtractFront(), "a");
+    const auto all = container.ExtractAll();
+    ASSERT_EQ(all.size(), size_t{ 1 });
+    ASSERT_EQ(*all.begin(), "b");
+    ASSERT_EQ(container.size(), size_t{ 0 });
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: pool of long-lived threads which can be shared between instances of ParallelExecutor-class
+// note: every submitted task is guaranteed to get own thread right away (the pool grows if there are not enough parked threads),
+// | because the tasks of one ParallelizationUnit-class instance may wait for each other.
+class ThreadPool {
+    using TaskType = std::function<void()>;
+
+    std::mutex _access_mutex{};
+    std::condition_variable _task_added{};
+    std::deque<TaskType> _tasks{};
+    std::vector<std::thread> _threads{};
+    // NOTE: quantity of parked threads which are not reserved for already queued tasks (negative while a new thread is starting)
+    ptrdiff_t _free_threads{};
+    bool _is_stopped{ false };
+
+    void _Worker() {
+        std::unique_lock lock(_access_mutex);
+        while (true) {
+            ++_free_threads;
+            _task_added.wait(lock, [this]() { return _is_stopped || !_tasks.empty(); });
+            if (_tasks.empty())
+                return;
+
+            TaskType task{ std::move(_tasks.front()) };
+            _tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    public:
+#pragma region constructors / destructor
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(_access_mutex);
+            _is_stopped = true;
+        }
+        _task_added.notify_all();
+        for (std::thread& th : _threads)
+            th.join();
+    }
+#pragma endregion constructors / destructor
+
+    // brief: returns the pool which is shared by all instances of ParallelExecutor-class by default
+    static std::shared_ptr<ThreadPool> Shared() {
+        static std::shared_ptr<ThreadPool> shared_pool{ std::make_shared<ThreadPool>() };
+        return shared_pool;
+    }
+
+    void Submit(TaskType&& task) {
+        {
+            std::lock_guard lock(_access_mutex);
+            if (_is_stopped)
+                throw std::exception("thread pool is stopped");
+
+            _tasks.emplace_back(std::move(task));
+            if (--_free_threads < 0)
+                _threads.emplace_back(&ThreadPool::_Worker, this);
+        }
+        _task_added.notify_one();
+    }
+
+    size_t GetThreadsQuantity() {
+        std::lock_guard lock(_access_mutex);
+        return _threads.size();
+    }
+};
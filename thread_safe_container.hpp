@@ -16,9 +16,25 @@ class ThreadSafeContainer : protected ContainerType<ElementType> {
 #pragma endregion inner types and aliases
 
     std::shared_ptr<std::mutex> _access_mutex_ptr{};
+    // NOTE: the index of the first element of the vector, the elements before it are already extracted (it is always zero for the list)
+    size_t _head{};
 
 #define GET_LOCK std::lock_guard _lock(*_access_mutex_ptr.get());
 
+    // brief: removes the extracted elements from the beginning of the vector when they take the half of it
+    // note: every element is moved by the compaction not more times than elements are extracted before it, so the extraction is O(1) amortized
+    void _Compact() {
+        if constexpr (IsBasedOf_V<std::vector>) {
+            if (_head == BaseType::size()) {
+                BaseType::clear();
+                _head = 0;
+            } else if (_head >= BaseType::size() / 2) {
+                BaseType::erase(BaseType::begin(), BaseType::begin() + _head);
+                _head = 0;
+            }
+        }
+    }
+
     public:
 #pragma region constructors / destructor
     ThreadSafeContainer(std::initializer_list<ElementType> args)
@@ -39,21 +55,55 @@ class ThreadSafeContainer : protected ContainerType<ElementType> {
         GET_LOCK
         OptElementType result;
 
-        if (BaseType::empty())
+        if (BaseType::size() == _head)
             return result;
 
         if constexpr (IsBasedOf_V<std::list>) {
-            result = BaseType::front();
+            result.emplace(std::move(BaseType::front()));
             BaseType::pop_front();
         } else if constexpr (IsBasedOf_V<std::vector>) {
-            result = BaseType::front();
-            BaseType::erase(BaseType::begin());
+            result.emplace(std::move(BaseType::operator[](_head++)));
+            _Compact();
         } else {
             static_assert(false, "ExtractFront-method cannot be used with currently defined ContainerType-type");
         }
         return result;
     }
 
+    // brief: extracts up to max_quantity elements from the front of the container by one locking
+    std::vector<ElementType> ExtractFrontBatch(const size_t max_quantity) {
+        GET_LOCK
+        std::vector<ElementType> result{};
+        const size_t quantity = std::min(max_quantity, BaseType::size() - _head);
+        result.reserve(quantity);
+
+        if constexpr (IsBasedOf_V<std::list>) {
+            for (size_t i{ 0 }; i < quantity; ++i) {
+                result.emplace_back(std::move(BaseType::front()));
+                BaseType::pop_front();
+            }
+        } else if constexpr (IsBasedOf_V<std::vector>) {
+            const auto first = BaseType::begin() + _head;
+            result.insert(result.end(), std::make_move_iterator(first), std::make_move_iterator(first + quantity));
+            _head += quantity;
+            _Compact();
+        } else {
+            static_assert(false, "ExtractFrontBatch-method cannot be used with currently defined ContainerType-type");
+        }
+        return result;
+    }
+
+    // brief: takes out all elements of the container by one locking, the container stays empty
+    BaseType ExtractAll() {
+        GET_LOCK
+        BaseType result{};
+        if constexpr (IsBasedOf_V<std::vector>)
+            BaseType::erase(BaseType::begin(), BaseType::begin() + _head);
+        _head = 0;
+        BaseType::swap(result);
+        return result;
+    }
+
     template<class... ArgsTypes>
     decltype(auto) emplace_front(ArgsTypes&&... args) {
         GET_LOCK
@@ -61,6 +111,11 @@ class ThreadSafeContainer : protected ContainerType<ElementType> {
         if constexpr (IsBasedOf_V<std::list>) {
             return BaseType::emplace_front(std::move(new_element));
         } else if constexpr (IsBasedOf_V<std::vector>) {
+            // NOTE: the place of the extracted element is reused, so the elements are not shifted
+            if (_head) {
+                BaseType::operator[](--_head) = std::move(new_element);
+                return BaseType::begin() + _head;
+            }
             return BaseType::insert(BaseType::begin(), std::move(new_element));
         } else {
             static_assert(false, "emplace_front-method cannot be used with currently defined ContainerType-type");
@@ -77,17 +132,29 @@ class ThreadSafeContainer : protected ContainerType<ElementType> {
         }
     }
 
+    // brief: adds the elements of the range to the end of the container by one locking
+    // note: to move the elements pass std::move_iterator-s
+    template<class IteratorType>
+    void emplace_back_range(IteratorType first, IteratorType last) {
+        GET_LOCK
+        if constexpr (IsBasedOf_V<std::list> || IsBasedOf_V<std::vector>) {
+            BaseType::insert(BaseType::end(), first, last);
+        } else {
+            static_assert(false, "emplace_back_range-method cannot be used with currently defined ContainerType-type");
+        }
+    }
+
 #pragma region iterator(s)
     // TODO: (?) is it need implement thread-safe iterator-class
 
     typename BaseType::iterator begin() noexcept {
         GET_LOCK
-        return BaseType::begin();
+        return std::next(BaseType::begin(), _head);
     }
 
     typename BaseType::const_iterator begin() const noexcept {
         GET_LOCK
-        return BaseType::begin();
+        return std::next(BaseType::begin(), _head);
     }
 
     typename BaseType::iterator end() noexcept {
@@ -103,13 +170,13 @@ class ThreadSafeContainer : protected ContainerType<ElementType> {
 
     size_t size() const {
         GET_LOCK
-        return BaseType::size();
+        return BaseType::size() - _head;
     }
 
     void reserve(size_t reserved_size) {
         GET_LOCK
         if constexpr (IsBasedOf_V<std::vector>)
-            BaseType::reserve(reserved_size);
+            BaseType::reserve(reserved_size + _head);
     }
 
 #undef GET_LOCK;
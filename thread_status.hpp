@@ -3,6 +3,7 @@
 #include "stdafx.hpp"
 
 // NOTE: any instance of this struct is impossible to copy
+// NOTE: every instance takes own cache line, so the statuses of neighbour threads in the table (see ParallelizationUnit-class) do not invalidate each other
 #define THREAD_STATUS_BODY                      \
     ThreadStatus() = default;                   \
     ThreadStatus(ThreadStatus&&) = delete;      \
@@ -10,7 +11,7 @@
     ThreadStatus& operator=(const ThreadStatus&) = delete;
 
 template<class ResultType>
-struct ThreadStatus {
+struct alignas(CACHE_LINE_SIZE) ThreadStatus {
     std::optional<std::thread::id> th_id{ std::nullopt };
     std::optional<ResultType> result{ std::nullopt };
     std::atomic_bool is_finished{ false };
@@ -18,7 +19,7 @@ struct ThreadStatus {
 };
 
 template<>
-struct ThreadStatus<void> {
+struct alignas(CACHE_LINE_SIZE) ThreadStatus<void> {
     std::optional<std::thread::id> th_id{ std::nullopt };
     std::atomic_bool is_finished{ false };
     THREAD_STATUS_BODY
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: the decision of the action of the controlled walk (see RecursiveWalking::WalkIn with WalkLimits-struct)
+// note: SKIP_SUBTREE of the action with catalog - the catalog is not entered,
+// | SKIP_SUBTREE of the action with file - the rest of entries of the catalog of the file are not given to the actions and are not entered;
+// | STOP - the walk is stopped, the actions which are already running are finished, but no new calls are made
+enum class WALK_DECISION : uint8_t { CONTINUE, SKIP_SUBTREE, STOP };
+
+// brief: the reason of the finish of the controlled walk (see WalkOutcome-struct)
+enum class WALK_STOP_REASON : uint8_t { COMPLETED, CANCELLED, STOPPED_BY_ACTION, DEADLINE, BUDGET };
+
+// brief: the flag of cancellation which is shared by all its copies, so the copy which is given to the walk is stopped by another copy
+// note: the walkers check the flag before every catalog and every entry, so the walk is stopped after the entry which is processed now
+class StopToken {
+    std::shared_ptr<std::atomic_bool> _is_stop_requested{ std::make_shared<std::atomic_bool>(false) };
+
+    public:
+    void RequestStop() noexcept {
+        _is_stop_requested->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsStopRequested() const noexcept {
+        return _is_stop_requested->load(std::memory_order_relaxed);
+    }
+};
+
+// brief: the limits of the controlled walk, every limit is optional
+struct WalkLimits {
+    std::optional<StopToken> stop_token{};
+    std::optional<std::chrono::steady_clock::time_point> deadline{};
+    // NOTE: the maximal quantity of entries (files and catalogs) which are given to the actions
+    std::optional<size_t> entry_budget{};
+};
+
+// brief: the result of the controlled walk
+struct WalkOutcome {
+    WALK_STOP_REASON reason{ WALK_STOP_REASON::COMPLETED };
+    // NOTE: the quantity of entries which are given to the actions
+    size_t entries{};
+};
+
+// brief: the state of one controlled walk which is shared by its walkers: the first reason of the stop and the counter of entries
+class WalkControl {
+    // NOTE: the deadline is checked once per this quantity of entries, because the reading of the clock is more expensive than the flag
+    static constexpr size_t DEADLINE_CHECK_PERIOD{ 64 };
+
+    const WalkLimits& _limits;
+    std::atomic<WALK_STOP_REASON> _reason{ WALK_STOP_REASON::COMPLETED };
+    std::atomic_size_t _entries{};
+
+    public:
+    WalkControl(const WalkLimits& limits)
+        : _limits{ limits } {}
+
+    WalkControl(const WalkControl&) = delete;
+    WalkControl& operator=(const WalkControl&) = delete;
+
+    bool IsStopped() const noexcept {
+        return _reason.load(std::memory_order_relaxed) != WALK_STOP_REASON::COMPLETED;
+    }
+
+    // brief: stops the walk, only the first reason is kept
+    void Stop(const WALK_STOP_REASON reason) noexcept {
+        WALK_STOP_REASON expected{ WALK_STOP_REASON::COMPLETED };
+        _reason.compare_exchange_strong(expected, reason, std::memory_order_relaxed);
+    }
+
+    // brief: checks the stop token and the deadline, it is called by the walker before the scan of every catalog
+    // return: whether the walk is stopped
+    bool Check() noexcept {
+        if (_limits.stop_token.has_value() && _limits.stop_token->IsStopRequested())
+            Stop(WALK_STOP_REASON::CANCELLED);
+        else if (_limits.deadline.has_value() && std::chrono::steady_clock::now() >= _limits.deadline.value())
+            Stop(WALK_STOP_REASON::DEADLINE);
+        return IsStopped();
+    }
+
+    // brief: the same as Check-method, but the deadline is checked only for every DEADLINE_CHECK_PERIOD-th entry of the walker
+    // param: walker_entries - the counter of entries of the walker
+    bool CheckEntry(size_t& walker_entries) noexcept {
+        if (_limits.stop_token.has_value() && _limits.stop_token->IsStopRequested())
+            Stop(WALK_STOP_REASON::CANCELLED);
+        else if (++walker_entries % DEADLINE_CHECK_PERIOD == 0 && _limits.deadline.has_value() && std::chrono::steady_clock::now() >= _limits.deadline.value())
+            Stop(WALK_STOP_REASON::DEADLINE);
+        return IsStopped();
+    }
+
+    // brief: takes one entry of the budget before the call of the action
+    // return: false if the budget is exhausted, the walk is stopped then
+    bool TakeEntry() noexcept {
+        const size_t taken = _entries.fetch_add(1, std::memory_order_relaxed);
+        if (_limits.entry_budget.has_value() && taken >= _limits.entry_budget.value()) {
+            _entries.fetch_sub(1, std::memory_order_relaxed);
+            Stop(WALK_STOP_REASON::BUDGET);
+            return false;
+        }
+        return true;
+    }
+
+    WalkOutcome GetOutcome() const noexcept {
+        return WalkOutcome{ _reason.load(std::memory_order_relaxed), _entries.load(std::memory_order_relaxed) };
+    }
+};
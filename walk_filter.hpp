@@ -0,0 +1,221 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#include <regex>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// brief: the type of file for WalkFilter::file_types
+// note: the symbolic link to catalog is walked as catalog, so the filter sees only the symbolic links to files and the broken ones
+enum class FILE_TYPE : uint8_t { REGULAR = 1 << 0, SYMLINK = 1 << 1, OTHER = 1 << 2 };
+
+// brief: the declarative filter of entries which is evaluated by walkers (see RecursiveWalking::WalkIn)
+// note: the file is given to the action only if it satisfies all set criteria, it is enough to match one element of every list;
+// | the filters of files do not affect catalogs, the catalogs are filtered only by exclude_directories
+struct WalkFilter {
+    // NOTE: the glob patterns of names of files ('*' - any sequence of symbols, '?' - any symbol), empty - any name
+    std::vector<std::string> names{};
+    // NOTE: the extensions of files with the dot (".json"), empty - any extension
+    std::vector<std::string> extensions{};
+    // NOTE: ECMAScript regular expression which must be found in the name of file, empty - any name
+    std::string name_regex{};
+    // NOTE: the glob patterns of names of catalogs which are not entered (".git", "node_modules", "build*"), such catalogs are never opened
+    std::vector<std::string> exclude_directories{};
+    std::optional<uint64_t> min_size{};
+    std::optional<uint64_t> max_size{};
+    // NOTE: the bounds of the time of the last modification in seconds since the Unix epoch
+    std::optional<int64_t> modified_after{};
+    std::optional<int64_t> modified_before{};
+    // NOTE: empty - any type
+    std::vector<FILE_TYPE> file_types{};
+};
+
+// brief: WalkFilter-struct which is prepared once per walk: the patterns are parsed, the regular expression is compiled,
+// | and the criteria are checked from the cheapest (the name) to the most expensive (the metadata which needs statx)
+// note: the instance is read by all walkers at the same time, so all its methods are constant
+class CompiledWalkFilter {
+    // brief: the glob pattern which is compared by the cheapest way for its form
+    class Glob {
+        enum class KIND : uint8_t { EXACT, PREFIX, SUFFIX, ANY, GENERAL };
+
+        KIND _kind;
+        std::string _text;
+
+        // NOTE: the backtracking is limited by the last '*', so the time is O(pattern * name) in the worst case
+        static bool _MatchGeneral(const std::string_view pattern, const std::string_view name) noexcept {
+            size_t p{ 0 }, n{ 0 }, star{ std::string_view::npos }, star_n{ 0 };
+            while (n < name.size()) {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+                    ++p;
+                    ++n;
+                } else if (p < pattern.size() && pattern[p] == '*') {
+                    star = p++;
+                    star_n = n;
+                } else if (star != std::string_view::npos) {
+                    p = star + 1;
+                    n = ++star_n;
+                } else {
+                    return false;
+                }
+            }
+            while (p < pattern.size() && pattern[p] == '*')
+                ++p;
+            return p == pattern.size();
+        }
+
+        public:
+        explicit Glob(const std::string& pattern) {
+            const size_t wildcards = std::count_if(pattern.begin(), pattern.end(), [](const char symbol) { return symbol == '*' || symbol == '?'; });
+            const bool is_single_star = wildcards == 1 && pattern.find('?') == std::string::npos;
+            if (wildcards == 0) {
+                _kind = KIND::EXACT;
+                _text = pattern;
+            } else if (pattern == "*") {
+                _kind = KIND::ANY;
+            } else if (is_single_star && pattern.back() == '*') {
+                _kind = KIND::PREFIX;
+                _text = pattern.substr(0, pattern.size() - 1);
+            } else if (is_single_star && pattern.front() == '*') {
+                _kind = KIND::SUFFIX;
+                _text = pattern.substr(1);
+            } else {
+                _kind = KIND::GENERAL;
+                _text = pattern;
+            }
+        }
+
+        bool Match(const std::string_view name) const noexcept {
+            switch (_kind) {
+                case KIND::EXACT:
+                    return name == _text;
+                case KIND::PREFIX:
+                    return name.substr(0, _text.size()) == _text;
+                case KIND::SUFFIX:
+                    return name.size() >= _text.size() && name.substr(name.size() - _text.size()) == _text;
+                case KIND::ANY:
+                    return true;
+                default:
+                    return _MatchGeneral(_text, name);
+            }
+        }
+    };
+
+    std::vector<Glob> _names{};
+    std::vector<std::string> _extensions{};
+    std::optional<std::regex> _name_regex{};
+    std::vector<Glob> _exclude_directories{};
+    uint64_t _min_size;
+    uint64_t _max_size;
+    int64_t _modified_after;
+    int64_t _modified_before;
+    // NOTE: the combination of FILE_TYPE-flags
+    uint8_t _file_types{};
+    bool _is_metadata_needed;
+
+    template<class PatternsType>
+    static bool _MatchAny(const PatternsType& patterns, const std::string_view name) noexcept {
+        return std::any_of(patterns.begin(), patterns.end(), [&](const Glob& pattern) { return pattern.Match(name); });
+    }
+
+    bool _IsNameMatched(const std::string_view name) const {
+        if (!_extensions.empty() && std::none_of(_extensions.begin(), _extensions.end(), [&](const std::string& extension) {
+                return name.size() > extension.size() && name.substr(name.size() - extension.size()) == extension;
+            }))
+            return false;
+        if (!_names.empty() && !_MatchAny(_names, name))
+            return false;
+        return !_name_regex.has_value() || std::regex_search(name.begin(), name.end(), _name_regex.value());
+    }
+
+    bool _IsMetadataMatched(const uint64_t size, const int64_t modification_time) const noexcept {
+        return size >= _min_size && size <= _max_size && modification_time >= _modified_after && modification_time <= _modified_before;
+    }
+
+    template<class EntryType>
+    static std::string _GetName(const EntryType& entry) {
+        return entry.path().filename().string();
+    }
+
+    public:
+    explicit CompiledWalkFilter(const WalkFilter& filter)
+        : _extensions{ filter.extensions }
+        , _min_size{ filter.min_size.value_or(0) }
+        , _max_size{ filter.max_size.value_or(UINT64_MAX) }
+        , _modified_after{ filter.modified_after.value_or(INT64_MIN) }
+        , _modified_before{ filter.modified_before.value_or(INT64_MAX) }
+        , _is_metadata_needed{ filter.min_size || filter.max_size || filter.modified_after || filter.modified_before } {
+        for (const std::string& pattern : filter.names)
+            _names.emplace_back(pattern);
+        for (const std::string& pattern : filter.exclude_directories)
+            _exclude_directories.emplace_back(pattern);
+        if (!filter.name_regex.empty())
+            _name_regex.emplace(filter.name_regex, std::regex::ECMAScript | std::regex::optimize);
+        for (const FILE_TYPE type : filter.file_types)
+            _file_types |= static_cast<uint8_t>(type);
+        if (!_file_types)
+            _file_types = static_cast<uint8_t>(FILE_TYPE::REGULAR) | static_cast<uint8_t>(FILE_TYPE::SYMLINK) | static_cast<uint8_t>(FILE_TYPE::OTHER);
+    }
+
+    // brief: checks whether the walker must not enter the catalog
+    // t-param: EntryType - the entry of the enumeration engine (see DirectoryEnumerator-struct)
+    template<class EntryType>
+    bool IsDirectoryExcluded(const EntryType& entry) const {
+        if (_exclude_directories.empty())
+            return false;
+        if constexpr (std::is_same_v<EntryType, fs::directory_entry>)
+            return _MatchAny(_exclude_directories, _GetName(entry));
+        else
+            return _MatchAny(_exclude_directories, entry.name());
+    }
+
+    // brief: checks whether the file satisfies all criteria of the filter
+    // note: the metadata is read (statx or std::filesystem) only if the filter has criteria of size or of time
+    template<class EntryType>
+    bool IsFileMatched(const EntryType& entry) const {
+        if constexpr (std::is_same_v<EntryType, fs::directory_entry>) {
+            if (!_IsNameMatched(_GetName(entry)))
+                return false;
+
+            std::error_code error{};
+            const fs::file_type type = entry.symlink_status(error).type();
+            const FILE_TYPE file_type{ type == fs::file_type::regular ? FILE_TYPE::REGULAR
+                                       : type == fs::file_type::symlink ? FILE_TYPE::SYMLINK
+                                                                       : FILE_TYPE::OTHER };
+            if (!(_file_types & static_cast<uint8_t>(file_type)))
+                return false;
+            if (!_is_metadata_needed)
+                return true;
+
+            // NOTE: the time of the file clock is converted to the system clock by the difference of their current times
+            const uint64_t size = entry.file_size(error);
+            const auto system_time = std::chrono::system_clock::now() + (entry.last_write_time(error) - fs::file_time_type::clock::now());
+            return !error && _IsMetadataMatched(size, std::chrono::duration_cast<std::chrono::seconds>(system_time.time_since_epoch()).count());
+        } else {
+#ifdef __linux__
+            if (!_IsNameMatched(entry.name()))
+                return false;
+
+            // NOTE: the type is taken from d_type, the metadata is read only if d_type is unknown or the filter needs the size or the time
+            uint8_t type{ entry.type() };
+            struct statx entry_statx;
+            if (type == DT_UNKNOWN || _is_metadata_needed) {
+                // NOTE: the name of the entry is terminated by zero, because it is the view of d_name
+                if (::statx(entry.dir_fd(), entry.name().data(), AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, STATX_TYPE | STATX_SIZE | STATX_MTIME, &entry_statx) != 0)
+                    return false;
+                type = static_cast<uint8_t>(IFTODT(entry_statx.stx_mode));
+            }
+            const FILE_TYPE file_type{ type == DT_REG ? FILE_TYPE::REGULAR : type == DT_LNK ? FILE_TYPE::SYMLINK : FILE_TYPE::OTHER };
+            if (!(_file_types & static_cast<uint8_t>(file_type)))
+                return false;
+            return !_is_metadata_needed || _IsMetadataMatched(entry_statx.stx_size, entry_statx.stx_mtime.tv_sec);
+#else
+            static_assert(false, "the entries of this engine are supported only on Linux");
+#endif
+        }
+    }
+};
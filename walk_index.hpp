@@ -0,0 +1,297 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// brief: the stamp of OS catalog which is changed when the list of its entries is changed
+// note: on Linux the stamp consists of the inode, the modification time and the change time (nanoseconds),
+// | on other OS - only of the modification time given by std::filesystem.
+struct DirectoryStamp {
+    uint64_t inode;
+    int64_t modification_time;
+    int64_t change_time;
+
+    bool operator==(const DirectoryStamp& other) const noexcept {
+        return inode == other.inode && modification_time == other.modification_time && change_time == other.change_time;
+    }
+
+    bool operator!=(const DirectoryStamp& other) const noexcept {
+        return !(*this == other);
+    }
+
+    // return: the stamp of the entry or std::nullopt if the entry is not available
+    static std::optional<DirectoryStamp> Get(const fs::path& path) noexcept {
+#ifdef __linux__
+        struct stat entry_stat;
+        if (::stat(path.c_str(), &entry_stat) != 0)
+            return std::nullopt;
+        return DirectoryStamp{
+            static_cast<uint64_t>(entry_stat.st_ino),
+            static_cast<int64_t>(entry_stat.st_mtim.tv_sec) * 1'000'000'000 + entry_stat.st_mtim.tv_nsec,
+            static_cast<int64_t>(entry_stat.st_ctim.tv_sec) * 1'000'000'000 + entry_stat.st_ctim.tv_nsec
+        };
+#else
+        std::error_code error{};
+        const fs::file_time_type time = fs::last_write_time(path, error);
+        if (error)
+            return std::nullopt;
+        return DirectoryStamp{ 0, std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(), 0 };
+#endif
+    }
+};
+
+// brief: the index of catalogs of the previous walk (see RecursiveWalking::WalkInIncremental): the stamp and the list of entries of every catalog
+// note: the file of the index is mapped to the memory and is read in place, the catalogs are found by binary search of their full paths
+// note: the format of the file:
+// | header: magic(u32), version(u32), quantity of catalogs(u64), offsets of catalogs sorted by their paths(u64[]);
+// | catalog: inode(u64), modification time(i64), change time(i64), path size(u32), quantity of entries(u32), entries size(u32), path, entries;
+// | entry: is directory(u8), name size(u16), name.
+class WalkIndex {
+    public:
+    static constexpr uint32_t MAGIC{ 0x58495752 }; // NOTE: "RWIX"
+    static constexpr uint32_t VERSION{ 1 };
+    static constexpr size_t HEADER_SIZE{ sizeof(uint32_t) * 2 + sizeof(uint64_t) };
+    static constexpr size_t RECORD_HEADER_SIZE{ sizeof(uint64_t) + sizeof(int64_t) * 2 + sizeof(uint32_t) * 3 };
+    static constexpr size_t ENTRY_HEADER_SIZE{ sizeof(uint8_t) + sizeof(uint16_t) };
+
+    // brief: the catalog stored in the index
+    struct DirectoryRecord {
+        DirectoryStamp stamp;
+        uint32_t entries_quantity;
+        // NOTE: the entries of the catalog in the format of the file
+        std::string_view entries;
+
+        // brief: calls the action(name, is_directory) for every stored entry of the catalog
+        template<class ActionType>
+        void ForEach(ActionType&& action) const {
+            for (size_t offset{ 0 }; offset < entries.size();) {
+                const bool is_directory = Read<uint8_t>(entries.data() + offset) != 0;
+                const uint16_t name_size = Read<uint16_t>(entries.data() + offset + sizeof(uint8_t));
+                action(entries.substr(offset + ENTRY_HEADER_SIZE, name_size), is_directory);
+                offset += ENTRY_HEADER_SIZE + name_size;
+            }
+        }
+    };
+
+    // NOTE: the data of the file is not aligned, so all values are copied
+    template<class ValueType>
+    static ValueType Read(const char* const data) noexcept {
+        ValueType result;
+        std::memcpy(&result, data, sizeof(ValueType));
+        return result;
+    }
+
+    private:
+    const char* _data{ nullptr };
+    size_t _size{};
+    uint64_t _records_quantity{};
+#ifdef __linux__
+    void* _mapping{ MAP_FAILED };
+#else
+    std::string _content{};
+#endif
+
+    std::string_view _GetPath(const uint64_t record_index) const noexcept {
+        const char* record = _data + Read<uint64_t>(_data + HEADER_SIZE + record_index * sizeof(uint64_t));
+        return std::string_view(record + RECORD_HEADER_SIZE, Read<uint32_t>(record + sizeof(uint64_t) + sizeof(int64_t) * 2));
+    }
+
+    void _Validate() {
+        if (_size < HEADER_SIZE || Read<uint32_t>(_data) != MAGIC || Read<uint32_t>(_data + sizeof(uint32_t)) != VERSION)
+            throw std::exception("file is not walk index or has unsupported version");
+
+        _records_quantity = Read<uint64_t>(_data + sizeof(uint32_t) * 2);
+        if ((_size - HEADER_SIZE) / sizeof(uint64_t) < _records_quantity)
+            throw std::exception("walk index is damaged");
+        for (uint64_t i{ 0 }; i < _records_quantity; ++i) {
+            const uint64_t offset = Read<uint64_t>(_data + HEADER_SIZE + i * sizeof(uint64_t));
+            if (offset > _size || _size - offset < RECORD_HEADER_SIZE)
+                throw std::exception("walk index is damaged");
+            const char* record = _data + offset;
+            const uint64_t path_size = Read<uint32_t>(record + sizeof(uint64_t) + sizeof(int64_t) * 2);
+            const uint64_t entries_size = Read<uint32_t>(record + sizeof(uint64_t) + sizeof(int64_t) * 2 + sizeof(uint32_t) * 2);
+            if (_size - offset - RECORD_HEADER_SIZE < path_size + entries_size)
+                throw std::exception("walk index is damaged");
+        }
+    }
+
+    public:
+#pragma region constructors / destructor
+    // brief: creates empty index
+    WalkIndex() = default;
+
+    // brief: loads the index from the file, if the file does not exist the index is empty
+    WalkIndex(const fs::path& index_file) {
+        if (!fs::exists(index_file))
+            return;
+#ifdef __linux__
+        const int fd = ::open(index_file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::exception("walk index can not be opened");
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            _size = static_cast<size_t>(file_stat.st_size);
+            _mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (_mapping == MAP_FAILED)
+            throw std::exception("walk index can not be mapped");
+        _data = static_cast<const char*>(_mapping);
+#else
+        std::ifstream file(index_file, std::ios_base::binary);
+        _content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        _data = _content.data();
+        _size = _content.size();
+#endif
+        _Validate();
+    }
+
+    WalkIndex(const WalkIndex&) = delete;
+    WalkIndex& operator=(const WalkIndex&) = delete;
+
+    ~WalkIndex() {
+#ifdef __linux__
+        if (_mapping != MAP_FAILED)
+            ::munmap(_mapping, _size);
+#endif
+    }
+#pragma endregion constructors / destructor
+
+    // return: the stored catalog or std::nullopt if the catalog is not stored in the index
+    std::optional<DirectoryRecord> Find(const std::string_view path) const noexcept {
+        uint64_t first{ 0 }, count{ _records_quantity };
+        while (count > 0) {
+            const uint64_t step = count / 2;
+            if (_GetPath(first + step) < path) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        if (first == _records_quantity || _GetPath(first) != path)
+            return std::nullopt;
+
+        const char* record = _data + Read<uint64_t>(_data + HEADER_SIZE + first * sizeof(uint64_t));
+        const char* sizes = record + sizeof(uint64_t) + sizeof(int64_t) * 2;
+        return DirectoryRecord{
+            DirectoryStamp{ Read<uint64_t>(record), Read<int64_t>(record + sizeof(uint64_t)), Read<int64_t>(record + sizeof(uint64_t) + sizeof(int64_t)) },
+            Read<uint32_t>(sizes + sizeof(uint32_t)),
+            std::string_view(record + RECORD_HEADER_SIZE + Read<uint32_t>(sizes), Read<uint32_t>(sizes + sizeof(uint32_t) * 2))
+        };
+    }
+
+    size_t size() const noexcept {
+        return static_cast<size_t>(_records_quantity);
+    }
+};
+
+// brief: collects catalogs of the current walk and saves them as the file of WalkIndex-class
+// note: walkers collect catalogs into own storages and merge them into the builder once at the end of the walk
+class WalkIndexBuilder {
+    public:
+    struct Record {
+        std::string path;
+        DirectoryStamp stamp;
+        uint32_t entries_quantity;
+        // NOTE: the entries of the catalog in the format of the file of WalkIndex-class
+        std::string entries;
+
+        void AddEntry(const std::string_view name, const bool is_directory) {
+            const uint16_t name_size = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+            const uint8_t is_directory_value = is_directory ? 1 : 0;
+            entries.append(reinterpret_cast<const char*>(&is_directory_value), sizeof(uint8_t));
+            entries.append(reinterpret_cast<const char*>(&name_size), sizeof(uint16_t));
+            entries.append(name.data(), name_size);
+            ++entries_quantity;
+        }
+    };
+
+    private:
+    std::mutex _access_mutex{};
+    std::vector<Record> _records{};
+    std::optional<int64_t> _racy_time{};
+
+    template<class ValueType>
+    static void _Write(std::ofstream& file, const ValueType value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(ValueType));
+    }
+
+    public:
+    // note: index_file - the file in which the index will be saved, it is used to get the time of the beginning of the walk by the clock of the file system
+    WalkIndexBuilder(const fs::path& index_file) {
+        const fs::path temporary_file = fs::path(index_file).concat(".tmp");
+        std::ofstream(temporary_file, std::ios_base::binary | std::ios_base::trunc).close();
+        if (std::optional<DirectoryStamp> stamp{ DirectoryStamp::Get(temporary_file) }; stamp.has_value())
+            _racy_time = stamp->modification_time;
+    }
+
+    WalkIndexBuilder(const WalkIndexBuilder&) = delete;
+    WalkIndexBuilder& operator=(const WalkIndexBuilder&) = delete;
+
+    // brief: checks that the stamp of catalog taken during the walk may be stored in the index
+    // note: the catalog which is changed at the same tick of the clock of the file system as it was scanned can be changed again without changing
+    // | of its stamp, so such catalogs (and all catalogs if the time of the beginning of the walk is unknown) are stored with empty stamp to be rescanned by the next walk
+    bool IsReliable(const DirectoryStamp& stamp) const noexcept {
+        return _racy_time.has_value() && stamp.modification_time < _racy_time.value();
+    }
+
+    void Merge(std::vector<Record>&& records) {
+        std::lock_guard lock(_access_mutex);
+        if (_records.empty()) {
+            _records = std::move(records);
+        } else {
+            _records.reserve(_records.size() + records.size());
+            std::move(records.begin(), records.end(), std::back_inserter(_records));
+        }
+    }
+
+    // brief: saves the index into the file, the file is replaced at once after the writing
+    // note: the previous index must not be mapped by WalkIndex-class on OS which can not replace mapped files
+    void Save(const fs::path& index_file) {
+        std::lock_guard lock(_access_mutex);
+        std::sort(_records.begin(), _records.end(), [](const Record& left, const Record& right) { return left.path < right.path; });
+
+        const fs::path temporary_file = fs::path(index_file).concat(".tmp");
+        {
+            std::ofstream file(temporary_file, std::ios_base::binary | std::ios_base::trunc);
+            if (!file)
+                throw std::exception("walk index can not be written");
+
+            _Write(file, WalkIndex::MAGIC);
+            _Write(file, WalkIndex::VERSION);
+            _Write(file, static_cast<uint64_t>(_records.size()));
+            uint64_t offset = WalkIndex::HEADER_SIZE + _records.size() * sizeof(uint64_t);
+            for (const Record& record : _records) {
+                _Write(file, offset);
+                offset += WalkIndex::RECORD_HEADER_SIZE + record.path.size() + record.entries.size();
+            }
+            for (const Record& record : _records) {
+                _Write(file, record.stamp.inode);
+                _Write(file, record.stamp.modification_time);
+                _Write(file, record.stamp.change_time);
+                _Write(file, static_cast<uint32_t>(record.path.size()));
+                _Write(file, record.entries_quantity);
+                _Write(file, static_cast<uint32_t>(record.entries.size()));
+                file.write(record.path.data(), record.path.size());
+                file.write(record.entries.data(), record.entries.size());
+            }
+            if (!file)
+                throw std::exception("walk index can not be written");
+        }
+        fs::rename(temporary_file, index_file);
+    }
+
+    size_t size() {
+        std::lock_guard lock(_access_mutex);
+        return _records.size();
+    }
+};
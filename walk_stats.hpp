@@ -0,0 +1,133 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: the statistics of the walk which are collected by walkers in instrumentation mode (see RecursiveWalking-class, IsInstrumented-template-parameter)
+// note: every walker writes only own counters, so the counters are not atomic and are separated by cache lines
+struct WalkStats {
+    using ClockType = std::chrono::steady_clock;
+
+    // brief: the span of the work of a walker for the trace (see WriteChromeTrace-method)
+    struct TraceEvent {
+        const char* name;
+        // NOTE: the times are counted from the start of the walk
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) WorkerStats {
+        size_t directories{};
+        size_t entries{};
+        size_t pushes{};
+        size_t pops{};
+        // NOTE: the time of the operations of the queue of catalogs: the waiting of its locks and the work under them
+        uint64_t lock_wait_ns{};
+        // NOTE: the time while the walker is parked because there are no catalogs for it
+        uint64_t idle_ns{};
+        // NOTE: the time of the enumeration of catalogs without the time of the actions (see Finish-method)
+        uint64_t enumeration_ns{};
+        uint64_t action_ns{};
+        std::vector<TraceEvent> events{};
+
+        WorkerStats& operator+=(const WorkerStats& other) noexcept {
+            directories += other.directories;
+            entries += other.entries;
+            pushes += other.pushes;
+            pops += other.pops;
+            lock_wait_ns += other.lock_wait_ns;
+            idle_ns += other.idle_ns;
+            enumeration_ns += other.enumeration_ns;
+            action_ns += other.action_ns;
+            return *this;
+        }
+    };
+
+    // brief: adds the time of its life to the counter of the walker and (optionally) the span to the trace of the walker
+    // note: the span is added only if the trace is requested (see is_tracing-field)
+    // t-param: IsEnabled - false makes the timer empty, so the walk without instrumentation does not pay for it
+    template<bool IsEnabled>
+    class Timer {
+        WorkerStats& _worker;
+        uint64_t WorkerStats::*_counter;
+        const char* _event_name;
+        ClockType::time_point _walk_start;
+        ClockType::time_point _start{ ClockType::now() };
+
+        public:
+        // param: event_name - the name of the span in the trace, nullptr - the span is not added to the trace
+        Timer(WalkStats* const stats, const size_t worker_index, uint64_t WorkerStats::*counter, const char* const event_name = nullptr)
+            : _worker{ stats->workers[worker_index] }
+            , _counter{ counter }
+            , _event_name{ stats->is_tracing ? event_name : nullptr }
+            , _walk_start{ stats->start } {}
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer() {
+            const ClockType::time_point finish = ClockType::now();
+            const uint64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - _start).count();
+            _worker.*_counter += duration_ns;
+            if (_event_name)
+                _worker.events.push_back(TraceEvent{
+                    _event_name, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_start - _walk_start).count()), duration_ns });
+        }
+    };
+
+    ClockType::time_point start{ ClockType::now() };
+    uint64_t duration_ns{};
+    std::vector<WorkerStats> workers;
+    // NOTE: the maximal quantity of walkers which work at the same time, it differs from the size of workers only with adaptive quantity of walkers
+    size_t peak_workers;
+    // NOTE: the spans of walkers are kept only with the trace, because they grow with the size of the tree (see RecursiveWalking::SetTracing)
+    bool is_tracing;
+
+    WalkStats(const size_t workers_quantity, const bool is_tracing_enabled = false)
+        : workers(workers_quantity)
+        , peak_workers{ workers_quantity }
+        , is_tracing{ is_tracing_enabled } {}
+
+    // brief: fixes the duration of the walk
+    // note: the actions are called during the enumeration of catalogs, so their time is subtracted from the time of the enumeration
+    void Finish() noexcept {
+        duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - start).count();
+        for (WorkerStats& worker : workers)
+            worker.enumeration_ns -= std::min(worker.action_ns, worker.enumeration_ns);
+    }
+
+    // brief: the sum of counters of all walkers (without events)
+    WorkerStats GetTotal() const noexcept {
+        WorkerStats result{};
+        for (const WorkerStats& worker : workers)
+            result += worker;
+        return result;
+    }
+
+    // brief: writes the spans of walkers in Chrome trace-event JSON format (can be opened by chrome://tracing or by Perfetto UI)
+    // note: every walker is shown as own thread, so the load imbalance and the waiting of walkers are visible on the timeline
+    // note: the walk without the trace (see is_tracing-field) has no spans, so only the names of walkers are written
+    void WriteChromeTrace(std::ostream& output) const {
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool is_first{ true };
+        auto separate = [&]() -> std::ostream& {
+            if (!is_first)
+                output << ",\n";
+            is_first = false;
+            return output;
+        };
+
+        for (size_t worker{ 0 }; worker < workers.size(); ++worker) {
+            separate() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << worker << ",\"args\":{\"name\":\"walker " << worker << "\"}}";
+            for (const TraceEvent& event : workers[worker].events)
+                separate() << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << worker << ",\"ts\":" << event.start_ns / 1e3
+                           << ",\"dur\":" << event.duration_ns / 1e3 << "}";
+        }
+        output << "]}" << std::endl;
+    }
+};
+
+template<>
+class WalkStats::Timer<false> {
+    public:
+    Timer(WalkStats* const, const size_t, uint64_t WorkerStats::*, const char* const = nullptr) noexcept {}
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "stdafx.hpp"
+
+// brief: set of per-worker deques where every worker extracts tasks from its own deque and steals them from the others only when its own deque is empty
+// t-param: ElementType - data-type of the task
+// t-param: IsLifo - order of extraction of tasks from own deque of a worker: true - the newest task first (LIFO), false - the oldest task first (FIFO)
+// note: stealing always takes the oldest task of the victim, because it is the task with the biggest work behind it (the closest to the root catalog)
+// note: a task is unfinished from its adding (see Emplace) until the worker reports its completion (see CompleteTask),
+// | so the workers which have nothing to do are parked until a new task is added or until the last task is completed (see ExtractOrWait).
+template<class ElementType, bool IsLifo>
+class WorkStealingQueue {
+#pragma region inner types and aliases
+    using OptElementType = std::optional<ElementType>;
+
+    struct alignas(CACHE_LINE_SIZE) WorkerDeque {
+        std::mutex access_mutex{};
+        std::deque<ElementType> tasks{};
+        // NOTE: the size is duplicated outside of the mutex, so that thieves can skip empty deques without locking them
+        std::atomic_size_t size_hint{};
+    };
+#pragma endregion inner types and aliases
+
+    size_t _workers_quantity;
+    std::unique_ptr<WorkerDeque[]> _deques;
+    std::atomic_size_t _registered_workers{};
+    std::atomic_size_t _unfinished_tasks{};
+    std::atomic_size_t _idle_workers{};
+    std::mutex _idle_mutex{};
+    std::condition_variable _idle_wakeup{};
+
+#define GET_LOCK(deque) std::lock_guard _lock(deque.access_mutex);
+
+    OptElementType _ExtractOwn(WorkerDeque& own) noexcept {
+        GET_LOCK(own)
+        OptElementType result;
+
+        if (own.tasks.empty())
+            return result;
+
+        if constexpr (IsLifo) {
+            result.emplace(std::move(own.tasks.back()));
+            own.tasks.pop_back();
+        } else {
+            result.emplace(std::move(own.tasks.front()));
+            own.tasks.pop_front();
+        }
+        own.size_hint = own.tasks.size();
+        return result;
+    }
+
+    OptElementType _Steal(const size_t thief_index) noexcept {
+        OptElementType result;
+        for (size_t i{ 1 }; i < _workers_quantity && !result.has_value(); ++i) {
+            WorkerDeque& victim = _deques[(thief_index + i) % _workers_quantity];
+            if (!victim.size_hint)
+                continue;
+
+            GET_LOCK(victim)
+            if (victim.tasks.empty())
+                continue;
+
+            result.emplace(std::move(victim.tasks.front()));
+            victim.tasks.pop_front();
+            victim.size_hint = victim.tasks.size();
+        }
+        return result;
+    }
+
+    public:
+#pragma region constructors / destructor
+    WorkStealingQueue(const size_t workers_quantity)
+        : _workers_quantity{ workers_quantity }
+        , _deques{ std::make_unique<WorkerDeque[]>(workers_quantity) } {
+        if (!_workers_quantity)
+            throw std::exception("quantity of workers must be greater then zero");
+    }
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+#pragma endregion constructors / destructor
+
+    // brief: gives to the calling worker the index of its own deque
+    // note: if there are more workers than deques, some of them will share one deque
+    size_t RegisterWorker() noexcept {
+        return _registered_workers++ % _workers_quantity;
+    }
+
+    template<class... ArgsTypes>
+    void Emplace(const size_t worker_index, ArgsTypes&&... args) {
+        ++_unfinished_tasks;
+        {
+            WorkerDeque& own = _deques[worker_index];
+            GET_LOCK(own)
+            own.tasks.emplace_back(std::forward<ArgsTypes>(args)...);
+            own.size_hint = own.tasks.size();
+        }
+        if (_idle_workers) {
+            std::lock_guard _lock(_idle_mutex);
+            _idle_wakeup.notify_one();
+        }
+    }
+
+    // brief: adds the tasks of the range to own deque of the worker by one locking
+    // note: to move the tasks pass std::move_iterator-s
+    template<class IteratorType>
+    void EmplaceRange(const size_t worker_index, IteratorType first, IteratorType last) {
+        const size_t quantity = static_cast<size_t>(std::distance(first, last));
+        if (!quantity)
+            return;
+
+        _unfinished_tasks += quantity;
+        {
+            WorkerDeque& own = _deques[worker_index];
+            GET_LOCK(own)
+            own.tasks.insert(own.tasks.end(), first, last);
+            own.size_hint = own.tasks.size();
+        }
+        if (_idle_workers) {
+            std::lock_guard _lock(_idle_mutex);
+            if (quantity == 1)
+                _idle_wakeup.notify_one();
+            else
+                _idle_wakeup.notify_all();
+        }
+    }
+
+    // brief: reports that the task extracted early is completed
+    void CompleteTask() {
+        if (--_unfinished_tasks == 0) {
+            std::lock_guard _lock(_idle_mutex);
+            _idle_wakeup.notify_all();
+        }
+    }
+
+    // brief: extracts a task from own deque of the worker, or steals it from another worker if own deque is empty
+    OptElementType Extract(const size_t worker_index) noexcept {
+        if (OptElementType result{ _ExtractOwn(_deques[worker_index]) }; result.has_value())
+            return result;
+        return _Steal(worker_index);
+    }
+
+    // brief: extracts a task like Extract-method, but if there is no task parks the worker until a new one appears
+    // return: the task or std::nullopt if all tasks are completed
+    OptElementType ExtractOrWait(const size_t worker_index) {
+        while (true) {
+            if (OptElementType result{ Extract(worker_index) }; result.has_value())
+                return result;
+
+            std::unique_lock lock(_idle_mutex);
+            ++_idle_workers;
+            _idle_wakeup.wait(lock, [this]() { return !_unfinished_tasks || size() > 0; });
+            --_idle_workers;
+            if (!_unfinished_tasks)
+                return std::nullopt;
+        }
+    }
+
+    // brief: the same as ExtractOrWait-method, but the worker is parked not longer than the timeout
+    // return: the task or std::nullopt if all tasks are completed or if the timeout is expired (see IsFinished-method)
+    template<class RepType, class PeriodType>
+    OptElementType ExtractOrWaitFor(const size_t worker_index, const std::chrono::duration<RepType, PeriodType>& timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            if (OptElementType result{ Extract(worker_index) }; result.has_value())
+                return result;
+
+            std::unique_lock lock(_idle_mutex);
+            ++_idle_workers;
+            const bool is_woken = _idle_wakeup.wait_until(lock, deadline, [this]() { return !_unfinished_tasks || size() > 0; });
+            --_idle_workers;
+            if (!_unfinished_tasks || !is_woken)
+                return std::nullopt;
+        }
+    }
+
+    // brief: drops all tasks which are not extracted yet, the extracted tasks must be completed as usual (see CompleteTask)
+    // note: the workers are woken if no unfinished tasks are left, so the stopped work is finished without waiting for the dropped tasks
+    // return: quantity of dropped tasks
+    size_t Clear() {
+        size_t dropped{};
+        for (size_t i{ 0 }; i < _workers_quantity; ++i) {
+            WorkerDeque& deque = _deques[i];
+            if (!deque.size_hint)
+                continue;
+
+            GET_LOCK(deque)
+            dropped += deque.tasks.size();
+            deque.tasks.clear();
+            deque.size_hint = 0;
+        }
+        if (dropped && (_unfinished_tasks -= dropped) == 0) {
+            std::lock_guard _lock(_idle_mutex);
+            _idle_wakeup.notify_all();
+        }
+        return dropped;
+    }
+
+    bool IsFinished() const noexcept {
+        return !_unfinished_tasks;
+    }
+
+    size_t size() const noexcept {
+        size_t result{};
+        for (size_t i{ 0 }; i < _workers_quantity; ++i)
+            result += _deques[i].size_hint;
+        return result;
+    }
+
+#undef GET_LOCK
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "stdafx.hpp"
+#include "thread_pool.hpp"
+
+// brief: the bounds and the triggers of the adaptive quantity of walkers (see RecursiveWalking::SetScaling)
+// note: the walk starts with min_workers walkers, a walker is added when the queue of catalogs grows or when the scan of one catalog is long
+// | (the walker is likely blocked by I/O), a walker is retired when it has no catalogs during retire_delay
+struct WalkScaling {
+    size_t min_workers{ 1 };
+    size_t max_workers{ std::max<size_t>(2, std::thread::hardware_concurrency()) * 4 };
+    // NOTE: a walker is added when the queue has more catalogs than this quantity per active walker
+    size_t catalogs_per_worker{ 4 };
+    std::chrono::microseconds stall_threshold{ 2000 };
+    std::chrono::milliseconds retire_delay{ 5 };
+};
+
+// brief: runs the copies of one worker in the pool of threads, the copies are added and retired by the workers themselves
+// | according to WalkScaling-struct, so there is no thread which only watches the others
+// note: every running copy owns the slot (the index from 0 to max_workers), the slot of the retired copy is given to the next added one,
+// | so the slots can be used as the indices of per-worker data (see WorkStealingQueue-class, WalkStats-struct)
+class WorkerScaler {
+    WalkScaling _scaling;
+    std::shared_ptr<ThreadPool> _thread_pool;
+    std::function<void()> _worker{};
+    // NOTE: the copies which are submitted and have not returned yet, it is limited by max_workers
+    std::atomic_size_t _running{};
+    // NOTE: the copies which are not retired, it is not less than min_workers (the copies which return on the finish are not subtracted)
+    std::atomic_size_t _active{};
+    std::atomic_size_t _peak{};
+    std::mutex _slots_mutex{};
+    std::vector<size_t> _free_slots{};
+    std::mutex _finish_mutex{};
+    std::condition_variable _finished{};
+
+    void _Submit() {
+        _thread_pool->Submit([this]() {
+            _worker();
+            if (--_running == 0) {
+                std::lock_guard lock(_finish_mutex);
+                _finished.notify_all();
+            }
+        });
+    }
+
+    public:
+#pragma region constructors / destructor
+    WorkerScaler(const WalkScaling& scaling, std::shared_ptr<ThreadPool> thread_pool = ThreadPool::Shared())
+        : _scaling{ scaling }
+        , _thread_pool{ std::move(thread_pool) } {
+        if (!_scaling.min_workers || _scaling.min_workers > _scaling.max_workers)
+            throw std::exception("quantity of workers must be greater then zero and must not exceed its maximum");
+        for (size_t slot{ _scaling.max_workers }; slot > 0; --slot)
+            _free_slots.push_back(slot - 1);
+    }
+
+    WorkerScaler(const WorkerScaler&) = delete;
+    WorkerScaler& operator=(const WorkerScaler&) = delete;
+#pragma endregion constructors / destructor
+
+    // brief: starts min_workers copies of the worker and waits while all copies (with the added ones) are finished
+    // note: the worker must take its slot by AcquireSlot-method and return it by ReleaseSlot-method before its finish
+    void Run(std::function<void()>&& worker) {
+        _worker = std::move(worker);
+        _running = _active = _peak = _scaling.min_workers;
+        for (size_t i{ 0 }; i < _scaling.min_workers; ++i)
+            _Submit();
+
+        std::unique_lock lock(_finish_mutex);
+        _finished.wait(lock, [this]() { return _running == 0; });
+    }
+
+    size_t AcquireSlot() {
+        std::lock_guard lock(_slots_mutex);
+        const size_t slot{ _free_slots.back() };
+        _free_slots.pop_back();
+        return slot;
+    }
+
+    void ReleaseSlot(const size_t slot) {
+        std::lock_guard lock(_slots_mutex);
+        _free_slots.push_back(slot);
+    }
+
+    // brief: adds one copy of the worker if the quantity of running copies is less than max_workers
+    // return: whether the copy is added
+    bool TryAdd() {
+        size_t running{ _running };
+        do {
+            if (running >= _scaling.max_workers)
+                return false;
+        } while (!_running.compare_exchange_weak(running, running + 1));
+
+        const size_t active{ ++_active };
+        for (size_t peak{ _peak }; peak < active && !_peak.compare_exchange_weak(peak, active);)
+            ;
+        _Submit();
+        return true;
+    }
+
+    // brief: allows the calling copy to retire if the quantity of active copies is greater than min_workers
+    // return: whether the copy must return
+    bool TryRetire() noexcept {
+        size_t active{ _active };
+        do {
+            if (active <= _scaling.min_workers)
+                return false;
+        } while (!_active.compare_exchange_weak(active, active - 1));
+        return true;
+    }
+
+    // brief: is called by the copy after the scan of one catalog, adds one copy if the queue is long for the active copies
+    // | or if the scan is long (the pending catalogs wait while the copy is blocked by I/O)
+    // param: pending - quantity of catalogs in the queue
+    // param: scan_duration - time of the scan of the catalog
+    void OnScanned(const size_t pending, const std::chrono::steady_clock::duration scan_duration) {
+        if (!pending)
+            return;
+        if (pending > _active.load(std::memory_order_relaxed) * _scaling.catalogs_per_worker || scan_duration >= _scaling.stall_threshold)
+            TryAdd();
+    }
+
+    std::chrono::milliseconds GetRetireDelay() const noexcept {
+        return _scaling.retire_delay;
+    }
+
+    // return: the maximal quantity of active copies during the run
+    size_t GetPeakWorkers() const noexcept {
+        return _peak;
+    }
+};